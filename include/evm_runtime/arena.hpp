@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace evm_runtime {
+
+// Bump allocator for memory that only lives as long as one transaction.
+//
+// Allocation is a pointer increment and deallocation is a no-op; everything is released at once
+// when the arena is destroyed, together with the state that owns it. Blocks start small, since a
+// plain transfer only caches a couple of entries, and double in size up to max_block_size.
+class arena {
+public:
+    static constexpr size_t default_block_size = 4 * 1024;
+    static constexpr size_t max_block_size = 64 * 1024;
+
+    explicit arena(size_t block_size = default_block_size) : _block_size(block_size) {}
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+    ~arena() { release(); }
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        uintptr_t p = align_up(_cur, alignment);
+        if (!_head || p + size > _end) {
+            grow(size + alignment);
+            p = align_up(_cur, alignment);
+        }
+        _used += p + size - _cur;
+        _cur = p + size;
+        return reinterpret_cast<void*>(p);
+    }
+
+    void deallocate(void*, size_t) noexcept {}
+
+    // Bytes handed out, including alignment padding
+    size_t used() const { return _used; }
+    // Bytes currently obtained from malloc
+    size_t reserved() const { return _reserved; }
+
+private:
+    struct block {
+        block* next;
+        size_t size;
+    };
+
+    static uintptr_t align_up(uintptr_t p, size_t alignment) {
+        return (p + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    }
+
+    void grow(size_t min_size) {
+        const size_t size = std::max(_block_size, min_size + sizeof(block));
+        _block_size = std::min(_block_size * 2, std::max(_block_size, max_block_size));
+        auto* b = static_cast<block*>(std::malloc(size));
+        b->next = _head;
+        b->size = size;
+        _head = b;
+        _cur = reinterpret_cast<uintptr_t>(b + 1);
+        _end = reinterpret_cast<uintptr_t>(b) + size;
+        _reserved += size;
+    }
+
+    void release() noexcept {
+        while (_head) {
+            block* next = _head->next;
+            _reserved -= _head->size;
+            std::free(_head);
+            _head = next;
+        }
+    }
+
+    size_t    _block_size;
+    block*    _head = nullptr;
+    uintptr_t _cur = 0;
+    uintptr_t _end = 0;
+    size_t    _used = 0;
+    size_t    _reserved = 0;
+};
+
+template <typename T>
+struct arena_allocator {
+    using value_type = T;
+
+    arena_allocator(arena& a) noexcept : _arena(&a) {}
+    template <typename U>
+    arena_allocator(const arena_allocator<U>& other) noexcept : _arena(other._arena) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T* p, size_t n) noexcept { _arena->deallocate(p, n * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const arena_allocator<U>& other) const noexcept { return _arena == other._arena; }
+    template <typename U>
+    bool operator!=(const arena_allocator<U>& other) const noexcept { return _arena != other._arena; }
+
+    arena* _arena;
+};
+
+template <typename K, typename V, typename Compare = std::less<K>>
+using arena_map = std::map<K, V, Compare, arena_allocator<std::pair<const K, V>>>;
+
+using arena_bytes = std::vector<char, arena_allocator<char>>;
+
+}  // namespace evm_runtime
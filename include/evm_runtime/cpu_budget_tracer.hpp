@@ -0,0 +1,86 @@
+#pragma once
+#include <evmc/instructions.h>
+#include <eosio/eosio.hpp>
+#include <evm_runtime/tables.hpp>
+namespace evm_runtime {
+
+// Aborts the transaction as soon as its estimated CPU goes over the budget the miner asked for,
+// instead of letting it run into the Antelope deadline after most of the work has been billed.
+// Costs that are known in advance are charged before the work they stand for: the transaction and
+// its encoded size before sender recovery and execution, and each frame with its code size before
+// its first instruction. Instructions are then charged as they run.
+struct cpu_budget_tracer : silkworm::EvmTracer {
+
+    cpu_budget_tracer(uint32_t max_cpu_us, const cpu_cost_model& model, size_t rlptx_size)
+        : budget_ns_(uint64_t(max_cpu_us) * 1000), model_(model) {
+        charge(model_.per_transaction + model_.per_tx_byte * rlptx_size);
+    }
+
+    uint64_t estimated_ns() const { return estimated_ns_; }
+
+    void on_execution_start(evmc_revision rev, const evmc_message& msg, evmone::bytes_view code) noexcept override {
+        // eosio::check aborts the action rather than throwing, so it is fine in a noexcept callback
+        charge(model_.per_frame + model_.per_code_byte * code.size());
+    }
+
+    void on_instruction_start(uint32_t pc, const intx::uint256* stack_top, int stack_height,
+                                int64_t gas, const evmone::ExecutionState& state,
+                                const silkworm::IntraBlockState& intra_block_state) override {
+
+        uint64_t cost = model_.per_instruction;
+        switch (state.original_code[pc]) {
+            case OP_SLOAD:
+            case OP_BALANCE:
+            case OP_EXTCODESIZE:
+            case OP_EXTCODECOPY:
+            case OP_EXTCODEHASH:
+                cost += model_.per_db_read;
+                break;
+            case OP_SSTORE:
+                cost += model_.per_db_write;
+                break;
+            case OP_CREATE:
+            case OP_CREATE2:
+                cost += model_.per_create;
+                break;
+            case OP_LOG0:
+            case OP_LOG1:
+            case OP_LOG2:
+            case OP_LOG3:
+            case OP_LOG4:
+                cost += model_.per_log;
+                break;
+            default:
+                break;
+        }
+        charge(cost);
+    }
+
+    void on_execution_end(const evmc_result& result, const silkworm::IntraBlockState& intra_block_state) noexcept override {
+
+    }
+
+    void on_creation_completed(const evmc_result& result, const silkworm::IntraBlockState& intra_block_state) noexcept override {
+
+    }
+
+    void on_precompiled_run(const evmc_result& result, int64_t gas,
+                                    const silkworm::IntraBlockState& intra_block_state) noexcept override {
+
+    }
+
+    void on_reward_granted(const silkworm::CallResult& result, const silkworm::IntraBlockState& intra_block_state) noexcept override {
+
+    }
+
+private:
+    void charge(uint64_t ns) {
+        estimated_ns_ += ns;
+        eosio::check(estimated_ns_ <= budget_ns_, "cpu budget exceeded");
+    }
+
+    uint64_t       budget_ns_;
+    uint64_t       estimated_ns_ = 0;
+    cpu_cost_model model_;
+};
+} //namespace evm_runtime
@@ -0,0 +1,25 @@
+#pragma once
+#include <eosio/time.hpp>
+
+namespace evm_runtime {
+
+/**
+ * @brief Integer version of eosevm::block_mapping::timestamp_to_evm_block_num for 1 second EVM blocks
+ *
+ * The shared implementation divides the timestamp by the double 1e6, which eos-vm executes through softfloat.
+ * Both give the same block number for every timestamp below 2^53 microseconds.
+ *
+ * @param genesis_time - the EVM genesis timestamp
+ * @param time - Antelope timestamp
+ * @return mapped EVM block number (0 for all timestamps prior to the genesis timestamp)
+ */
+inline uint32_t timestamp_to_evm_block_num(eosio::time_point_sec genesis_time, eosio::time_point time) {
+    const uint64_t genesis_timestamp = genesis_time.sec_since_epoch();
+    const uint64_t timestamp = time.time_since_epoch().count() / 1'000'000;
+    if (timestamp < genesis_timestamp) {
+        return 0;
+    }
+    return 1 + (timestamp - genesis_timestamp);
+}
+
+} //namespace evm_runtime
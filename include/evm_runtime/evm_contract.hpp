@@ -18,6 +18,7 @@ using namespace eosio;
 namespace evm_runtime {
 
 struct gas_prices_type;
+struct cpu_cost_model;
 
 class [[eosio::contract]] evm_contract : public contract
 {
@@ -59,9 +60,76 @@ public:
     */
    [[eosio::action]] void freeze(bool value);
 
+   /**
+    * @brief Enable (or disable) the compact form of the evmtx event.
+    *
+    * When enabled, transactions pushed through the pushtx action emit an evmtx_compact event which does not repeat
+    * the rlptx already present in the pushtx action data. Synthesized transactions (bridge deposits, call, admincall)
+    * always emit the full form; deposits can be shortened separately with fastdeposit.
+    *
+    * @param value If true, emit compact evmtx events for pushtx. If false, always emit the full form.
+    */
+   [[eosio::action]] void compactevmtx(bool value);
+
+   /**
+    * @brief Enable (or disable) crediting bridge deposits without running the EVM.
+    *
+    * When enabled and the EVM version is 1 or 2, a deposit to an existing account without code is credited
+    * directly and announced with an evmtx_deposit event, from which EVM nodes replay the equivalent bridge
+    * transaction. Nodes must understand evmtx_deposit before this is turned on. Independent of compactevmtx.
+    *
+    * @param value If true, credit such deposits directly. If false, always run the bridge transaction.
+    */
+   [[eosio::action]] void fastdeposit(bool value);
+
    [[eosio::action]] void exec(const exec_input& input, const std::optional<exec_callback>& callback);
 
-   [[eosio::action]] void pushtx(eosio::name miner, bytes rlptx, eosio::binary_extension<uint64_t> min_inclusion_price);
+   /**
+    * @brief Execute a signed EVM transaction
+    *
+    * @param miner Account that receives the miner portion of the gas fee.
+    * @param rlptx RLP encoded transaction. Not deserialized by the dispatcher, see pushtx implementation.
+    * @param min_inclusion_price Optional minimum inclusion price required by the miner (evm_version >= 1).
+    * @param max_cpu_us Optional CPU budget in microseconds. The transaction fails with "cpu budget exceeded" as soon as
+    * its estimated CPU goes over it; the fixed and size dependent parts are checked before execution. Without it no
+    * estimate is kept at all. Requires min_inclusion_price to be present.
+    */
+   [[eosio::action]] void pushtx(eosio::name miner, eosio::ignore<bytes> rlptx, eosio::ignore<eosio::binary_extension<uint64_t>> min_inclusion_price, eosio::ignore<eosio::binary_extension<uint32_t>> max_cpu_us);
+
+   /**
+    * @brief Append a chunk of an RLP encoded transaction to the miner's staging area
+    *
+    * Large transactions (typically contract deployments) can be uploaded over several actions, committed with
+    * stagecommit and executed with pushstaged. The miner pays for the RAM of the staging area. Each chunk is stored
+    * in its own row, so an upload only costs the size of its chunk. Requires evm_version >= 1.
+    */
+   [[eosio::action]] void stagechunk(eosio::name miner, const bytes& chunk);
+
+   /**
+    * @brief Seal the staged transaction and record its hash
+    *
+    * Joins the chunks, decodes the transaction and recovers its sender, which pushstaged reuses instead of recovering
+    * it again. No more chunks can be appended afterwards. Requires evm_version >= 1.
+    */
+   [[eosio::action]] void stagecommit(eosio::name miner);
+
+   /**
+    * @brief Execute the committed staged transaction as pushtx would and release the staging area
+    *
+    * The runtime configuration is the one of pushtx. Requires evm_version >= 1, since EVM nodes can only pick up the
+    * transaction from the evmtx event.
+    *
+    * @param miner Account that receives the miner portion of the gas fee.
+    * @param hash Expected keccak256 of the staged RLP encoded transaction (the EVM transaction hash).
+    * @param min_inclusion_price Optional minimum inclusion price required by the miner, as in pushtx.
+    * @param max_cpu_us Optional CPU budget in microseconds, as in pushtx. Requires min_inclusion_price to be present.
+    */
+   [[eosio::action]] void pushstaged(eosio::name miner, const bytes& hash, const eosio::binary_extension<uint64_t>& min_inclusion_price, const eosio::binary_extension<uint32_t>& max_cpu_us);
+
+   /**
+    * @brief Discard the miner's staging area
+    */
+   [[eosio::action]] void stagereset(eosio::name miner);
 
    [[eosio::action]] void open(eosio::name owner);
 
@@ -91,6 +159,13 @@ public:
 
    [[eosio::action]] void setgasprices(const gas_prices_type& prices);
 
+   /**
+    * @brief Set the CPU cost estimates used by the max_cpu_us guard of pushtx and pushstaged
+    *
+    * The estimates only decide when a miner's own budget aborts a transaction, so they do not affect EVM state.
+    */
+   [[eosio::action]] void setcpumodel(const cpu_cost_model& model);
+
    // Events
    [[eosio::action]] void evmtx(eosio::ignore<evm_runtime::evmtx_type> event){
       eosio::check(get_sender() == get_self(), "forbidden to call");
@@ -123,15 +198,27 @@ public:
    [[eosio::action]] void dumpall();
    [[eosio::action]] void setbal(const bytes& addy, const bytes& bal);
    [[eosio::action]] void testbaldust(const name test);
+   [[eosio::action]] std::vector<bytes> testkeccak(const bytes& data);
 #endif
 
 private:
    void open_internal_balance(eosio::name owner);
-   std::shared_ptr<struct config_wrapper> _config;
+
+   // Reads the config singleton on first access, so actions that return before looking at it (events, transfer
+   // notifications of other tokens) skip the table read.
+   struct lazy_config {
+      eosio::name self;
+      std::shared_ptr<struct config_wrapper> wrapper;
+
+      struct config_wrapper* operator->();
+   };
+   lazy_config _config;
 
    enum class status_flags : uint32_t
    {
-      frozen = 0x1
+      frozen        = 0x1,
+      compact_evmtx = 0x2,
+      fast_deposit  = 0x4
    };
 
    void assert_inited();
@@ -151,7 +238,8 @@ private:
 
    using pushtx_action = eosio::action_wrapper<"pushtx"_n, &evm_contract::pushtx>;
 
-   void process_tx(const runtime_config& rc, eosio::name miner, const transaction& tx, std::optional<uint64_t> min_inclusion_price);
+   runtime_config pushtx_runtime_config();
+   void process_tx(const runtime_config& rc, eosio::name miner, const transaction& tx, std::optional<uint64_t> min_inclusion_price, std::optional<uint32_t> max_cpu_us = {});
    void dispatch_tx(const runtime_config& rc, const transaction& tx);
 };
 
@@ -0,0 +1,83 @@
+#pragma once
+#include <evmc/instructions.h>
+#include <eosio/eosio.hpp>
+namespace evm_runtime {
+
+// Counts executed instruction sequences that an interpreter could run as a single fused handler.
+// Sequences are only matched across instructions executed back to back in the same frame.
+struct fusion_stats_tracer : silkworm::EvmTracer {
+
+    uint64_t instructions = 0;
+    uint64_t push_jumpi = 0;   // PUSHn JUMPI
+    uint64_t push_jump = 0;    // PUSHn JUMP
+    uint64_t push1_add = 0;    // PUSH1 ADD
+    uint64_t selector = 0;     // DUP1 PUSH4 EQ PUSH2 JUMPI
+
+    const evmone::ExecutionState* state_ = nullptr;
+    uint32_t next_pc_ = 0;
+    uint8_t window_[4] = {};
+    size_t window_size_ = 0;
+
+    static bool is_push(uint8_t opcode) { return opcode >= OP_PUSH1 && opcode <= OP_PUSH32; }
+
+    void on_execution_start(evmc_revision rev, const evmc_message& msg, evmone::bytes_view code) noexcept override {
+        window_size_ = 0;
+    }
+
+    void on_instruction_start(uint32_t pc, const intx::uint256* stack_top, int stack_height,
+                                int64_t gas, const evmone::ExecutionState& state,
+                                const silkworm::IntraBlockState& intra_block_state) override {
+
+        const uint8_t opcode = state.original_code[pc];
+        ++instructions;
+
+        if (&state != state_ || pc != next_pc_) {
+            window_size_ = 0;
+            state_ = &state;
+        }
+        next_pc_ = pc + 1 + (is_push(opcode) ? opcode - OP_PUSH1 + 1 : 0);
+
+        const uint8_t prev = window_size_ > 0 ? window_[(window_size_ - 1) % 4] : 0;
+        if (window_size_ > 0 && is_push(prev)) {
+            if (opcode == OP_JUMPI) ++push_jumpi;
+            if (opcode == OP_JUMP) ++push_jump;
+            if (opcode == OP_ADD && prev == OP_PUSH1) ++push1_add;
+        }
+        if (opcode == OP_JUMPI && window_size_ >= 4 &&
+            window_[(window_size_ - 4) % 4] == OP_DUP1 && window_[(window_size_ - 3) % 4] == OP_PUSH4 &&
+            window_[(window_size_ - 2) % 4] == OP_EQ && window_[(window_size_ - 1) % 4] == OP_PUSH2) {
+            ++selector;
+        }
+
+        window_[window_size_ % 4] = opcode;
+        ++window_size_;
+    }
+
+    void on_execution_end(const evmc_result& result, const silkworm::IntraBlockState& intra_block_state) noexcept override {
+        // Execution continues in the caller frame, which must not match against this frame's window
+        state_ = nullptr;
+    }
+
+    void on_creation_completed(const evmc_result& result, const silkworm::IntraBlockState& intra_block_state) noexcept override {
+
+    }
+
+    void on_precompiled_run(const evmc_result& result, int64_t gas,
+                                    const silkworm::IntraBlockState& intra_block_state) noexcept override {
+
+    }
+
+    void on_reward_granted(const silkworm::CallResult& result, const silkworm::IntraBlockState& intra_block_state) noexcept override {
+
+    }
+
+    // Dispatches saved if every matched sequence ran as one handler. The selector sequence ends
+    // with PUSH2 JUMPI, which is already counted in push_jumpi.
+    uint64_t saved_dispatches() const { return push_jumpi + push_jump + push1_add + 3 * selector; }
+
+    void print() const {
+        eosio::print("FUSION: instructions=", instructions, " push_jumpi=", push_jumpi, " push_jump=", push_jump,
+                     " push1_add=", push1_add, " selector=", selector, " saved=", saved_dispatches(), "\n");
+    }
+};
+} //namespace evm_runtime
@@ -6,6 +6,7 @@ struct runtime_config {
   bool abort_on_failure        = false;
   bool enforce_chain_id        = true;
   bool allow_non_self_miner    = true;
+  bool rlptx_in_parent_action  = false;
 };
 
 struct gas_parameter_type {
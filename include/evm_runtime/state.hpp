@@ -3,6 +3,7 @@
 #include <vector>
 #include <map>
 #include <eosio/eosio.hpp>
+#include <evm_runtime/arena.hpp>
 #include <evm_runtime/types.hpp>
 #include <silkworm/core/state/state.hpp>
 
@@ -28,8 +29,10 @@ struct state : State {
     name _ram_payer;
     bool _read_only;
     bool _allow_frozen;
-    mutable std::map<evmc::address, uint64_t> addr2id;
-    mutable std::map<bytes32, bytes> addr2code;
+    // Caches only live as long as the state object, keep them out of the general purpose heap
+    mutable arena _arena;
+    mutable arena_map<evmc::address, uint64_t> addr2id{_arena};
+    mutable arena_map<bytes32, arena_bytes> addr2code{_arena};
     mutable db_stats stats;
     std::optional<config2> _config2;
 
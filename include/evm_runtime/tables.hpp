@@ -129,10 +129,10 @@ struct [[eosio::table("inevm")]] [[eosio::contract("evm_contract")]] balance_wit
     balance_with_dust& operator+=(const intx::uint256& amount) {
 
         check(balance.symbol != eosio::symbol(), "symbol can't be empty in balance_with_dust");
-        intx::uint256 minimum_natively_representable = pow10_const(evm_precision - balance.symbol.precision());
-        uint64_t min_asset = minimum_natively_representable[0];
+        const int exponent = evm_precision - balance.symbol.precision();
+        const uint64_t min_asset = pow10_const(exponent);
 
-        const intx::div_result<intx::uint256> div_result = udivrem(amount, minimum_natively_representable);
+        const intx::div_result<intx::uint256> div_result = udivrem_pow10(amount, exponent);
 
         //asset::max_amount is conservative at 2^62-1, this means two max_amounts of (2^62-1)+(2^62-1) cannot
         // overflow an int64_t which can represent up to 2^63-1. In other words, asset::max_amount+asset::max_amount
@@ -162,10 +162,10 @@ struct [[eosio::table("inevm")]] [[eosio::contract("evm_contract")]] balance_wit
     balance_with_dust& operator-=(const intx::uint256& amount) {
 
         check(balance.symbol != eosio::symbol(), "symbol can't be empty in balance_with_dust");
-        intx::uint256 minimum_natively_representable = pow10_const(evm_precision - balance.symbol.precision());
-        uint64_t min_asset = minimum_natively_representable[0];
+        const int exponent = evm_precision - balance.symbol.precision();
+        const uint64_t min_asset = pow10_const(exponent);
 
-        const intx::div_result<intx::uint256> div_result = udivrem(amount, minimum_natively_representable);
+        const intx::div_result<intx::uint256> div_result = udivrem_pow10(amount, exponent);
 
         check(div_result.quot <= balance.amount, "decrementing more than available");
 
@@ -197,6 +197,26 @@ typedef eosio::multi_index<"balances"_n, balance> balances;
 
 typedef eosio::singleton<"inevm"_n, balance_with_dust> inevm_singleton;
 
+// Estimated CPU cost, in nanoseconds, of the pieces of a transaction the contract pays for. Used by the cpu budget
+// guard of pushtx (see cpu_budget_tracer), which adds these up because a contract cannot read the CPU time it has
+// used. The defaults are unmeasured hand estimates meant to err on the high side. Producers should re-derive them
+// on their own hardware with benchmark_tests/cpu_cost_calibration and install them with setcpumodel.
+struct [[eosio::table]] [[eosio::contract("evm_contract")]] cpu_cost_model {
+    uint64_t per_transaction = 150'000;  // sender recovery, block setup and write back
+    uint64_t per_tx_byte     = 20;       // decoding and hashing the rlptx
+    uint64_t per_instruction = 60;
+    uint64_t per_frame       = 8'000;    // CALL*, CREATE* and the top level message
+    uint64_t per_code_byte   = 5;        // jumpdest analysis of the frame's code
+    uint64_t per_db_read     = 3'000;    // SLOAD, BALANCE, EXTCODE*
+    uint64_t per_db_write    = 6'000;    // SSTORE, read now and written back at the end
+    uint64_t per_create      = 20'000;   // code hashing and the account_code row
+    uint64_t per_log         = 1'000;
+
+    EOSLIB_SERIALIZE(cpu_cost_model, (per_transaction)(per_tx_byte)(per_instruction)(per_frame)(per_code_byte)(per_db_read)(per_db_write)(per_create)(per_log));
+};
+
+typedef eosio::singleton<"cpumodel"_n, cpu_cost_model> cpu_cost_model_singleton;
+
 struct [[eosio::table]] [[eosio::contract("evm_contract")]] nextnonce {
     name     owner;
     uint64_t next_nonce = 0;
@@ -296,4 +316,27 @@ struct [[eosio::table]] [[eosio::contract("evm_contract")]] prices_queue
 };
 typedef eosio::multi_index<"pricesqueue"_n, prices_queue> prices_queue_table;
 
+struct [[eosio::table]] [[eosio::contract("evm_contract")]] staged_chunk
+{
+    uint64_t seq;
+    bytes    data;
+
+    uint64_t primary_key()const { return seq; }
+
+    EOSLIB_SERIALIZE(staged_chunk, (seq)(data));
+};
+typedef eosio::multi_index<"stagedchunk"_n, staged_chunk> staged_chunk_table;
+
+struct [[eosio::table]] [[eosio::contract("evm_contract")]] staged_tx
+{
+    bytes rlptx;
+    bytes hash;   // keccak256 of rlptx
+    bytes sender; // recovered at commit time
+
+    uint64_t primary_key()const { return 0; }
+
+    EOSLIB_SERIALIZE(staged_tx, (rlptx)(hash)(sender));
+};
+typedef eosio::multi_index<"stagedtx"_n, staged_tx> staged_tx_table;
+
 } //namespace evm_runtime
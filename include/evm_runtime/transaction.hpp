@@ -14,26 +14,30 @@ using silkworm::ByteView;
 struct transaction {
 
   transaction() = delete;
-  explicit transaction(bytes rlptx) : rlptx_(std::move(rlptx)) {}
+  // rlptx is not copied, the buffer it points to (usually the action data) must outlive this object.
+  explicit transaction(ByteView rlptx) : rlptx_(rlptx) {}
+  // The sender was already recovered from this same rlptx, recover_sender() just restores it.
+  transaction(ByteView rlptx, const evmc::address& sender) : rlptx_(rlptx), sender_(sender) {}
   explicit transaction(silkworm::Transaction tx) : tx_(std::move(tx)) {}
 
-  const bytes& get_rlptx()const {
-    if(!rlptx_) {
+  ByteView get_rlptx()const {
+    if(rlptx_) {
+      return rlptx_.value();
+    }
+    if(!encoded_) {
       eosio::check(tx_.has_value(), "no tx");
-      Bytes rlp;
-      silkworm::rlp::encode(rlp, tx_.value());
-      rlptx_.emplace(bytes{rlp.begin(), rlp.end()});
+      encoded_.emplace();
+      silkworm::rlp::encode(encoded_.value(), tx_.value());
     }
-    return rlptx_.value();
+    return ByteView{encoded_.value()};
   }
 
   const silkworm::Transaction& get_tx()const {
     if(!tx_) {
       eosio::check(rlptx_.has_value(), "no rlptx");
-      ByteView bv{(const uint8_t*)rlptx_->data(), rlptx_->size()};
-      silkworm::Transaction tmp;
-      eosio::check(silkworm::rlp::decode_transaction(bv, tmp, silkworm::rlp::Eip2718Wrapping::kNone) && bv.empty(), "unable to decode transaction");
-      tx_.emplace(tmp);
+      ByteView bv{rlptx_.value()};
+      tx_.emplace();
+      eosio::check(silkworm::rlp::decode_transaction(bv, tx_.value(), silkworm::rlp::Eip2718Wrapping::kNone) && bv.empty(), "unable to decode transaction");
     }
     return tx_.value();
   }
@@ -41,12 +45,19 @@ struct transaction {
   void recover_sender()const {
     eosio::check(tx_.has_value(), "no tx");
     auto& tx = tx_.value();
+    if(sender_) {
+      tx.from = sender_;
+      return;
+    }
     tx.from.reset();
     tx.recover_sender();
   }
 
 private:
-  mutable std::optional<bytes>  rlptx_;
+  // Only ever points to a buffer outside this object, so copies and moves stay valid
+  std::optional<ByteView>         rlptx_;
+  std::optional<evmc::address>    sender_;
+  mutable std::optional<Bytes>    encoded_; // owns the rlp of transactions built inside the contract
   mutable std::optional<silkworm::Transaction> tx_;
 };
 
@@ -18,6 +18,17 @@ namespace evm_runtime {
 
    uint64_t pow10_const(int v);
 
+   // x / 10^exponent and x % 10^exponent, using precomputed reciprocals for the exponents a token
+   // precision can produce (0 to 18) instead of a generic 256 bit division.
+   intx::div_result<intx::uint256> udivrem_pow10(const intx::uint256& x, int exponent);
+
+   // out = a * b. Returns false if the product doesn't fit in 256 bits. Cheaper than widening to
+   // uint512 on wasm32, where every 64x64->128 bit multiply is a compiler-rt call.
+   bool checked_mul(uint64_t a, const intx::uint256& b, intx::uint256& out);
+
+   // x * part / hundred_percent for part <= hundred_percent, rounded down, without widening to uint512.
+   intx::uint256 mul_hundred_percent(const intx::uint256& x, uint32_t part);
+
    constexpr unsigned evm_precision = 18;
    constexpr eosio::name default_token_account = "eosio.token"_n;
 
@@ -95,7 +106,29 @@ namespace evm_runtime {
       EOSLIB_SERIALIZE_DERIVED(evmtx_v3, evmtx_base, (overhead_price)(storage_price));
    };
 
-   using evmtx_type = std::variant<evmtx_v1, evmtx_v3>;
+   // Emitted for transactions whose rlptx is already part of the parent pushtx action data.
+   // The EVM node takes the transaction from the parent action instead of from the event.
+   struct evmtx_compact {
+      uint64_t  eos_evm_version;
+      uint32_t  tx_index;         // index of the transaction inside the parent action (always 0 for pushtx)
+      uint64_t  base_fee_per_gas; // evm_version 1 and 2
+      uint64_t  overhead_price;   // evm_version >= 3
+      uint64_t  storage_price;    // evm_version >= 3
+      EOSLIB_SERIALIZE(evmtx_compact, (eos_evm_version)(tx_index)(base_fee_per_gas)(overhead_price)(storage_price));
+   };
+
+   // Emitted for bridge deposits credited without running the EVM. EVM nodes apply it by executing
+   // the equivalent bridge transaction (legacy, 21000 gas, r=0, s=contract account) with these fields.
+   struct evmtx_deposit {
+      uint64_t  eos_evm_version;
+      uint64_t  nonce;
+      uint64_t  gas_price;
+      bytes     to;
+      bytes     value;            // uint256 big endian
+      EOSLIB_SERIALIZE(evmtx_deposit, (eos_evm_version)(nonce)(gas_price)(to)(value));
+   };
+
+   using evmtx_type = std::variant<evmtx_v1, evmtx_v3, evmtx_compact, evmtx_deposit>;
 
    struct fee_parameters
    {
@@ -1,16 +1,15 @@
 #pragma once
 #include <eosio/time.hpp>
 #include <eosio/print.hpp>
-#include <eosevm/block_mapping.hpp>
+#include <evm_runtime/evm_block_num.hpp>
 
 #define VALUE_PROMOTER_PENDING(T)\
     struct T##_pending {\
         T value;\
         time_point time;\
         bool is_active(time_point_sec genesis_time, time_point current_time)const {\
-            eosevm::block_mapping bm(genesis_time.sec_since_epoch());\
-            auto current_block_num = bm.timestamp_to_evm_block_num(current_time.time_since_epoch().count());\
-            auto pending_block_num = bm.timestamp_to_evm_block_num(time.time_since_epoch().count());\
+            auto current_block_num = evm_runtime::timestamp_to_evm_block_num(genesis_time, current_time);\
+            auto pending_block_num = evm_runtime::timestamp_to_evm_block_num(genesis_time, time);\
             return current_block_num > pending_block_num;\
         }\
     };
@@ -9,8 +9,16 @@
 #include <evm_runtime/eosio.token.hpp>
 #include <evm_runtime/bridge.hpp>
 #include <evm_runtime/config_wrapper.hpp>
+#include <evm_runtime/cpu_budget_tracer.hpp>
+#ifdef WITH_FUSION_STATS
+#include <evm_runtime/fusion_stats_tracer.hpp>
+#endif
+
+#include <ethash/keccak.hpp>
 
 #include <silkworm/core/protocol/trust_rule_set.hpp>
+#include <silkworm/core/protocol/param.hpp>
+#include <silkworm/core/execution/precompile.hpp>
 // included here so NDEBUG is defined to disable assert macro
 #include <silkworm/core/execution/processor.hpp>
 
@@ -38,7 +46,14 @@ static constexpr char err_msg_invalid_addr[] = "invalid address";
 using namespace silkworm;
 
 evm_contract::evm_contract(eosio::name receiver, eosio::name code, const datastream<const char*>& ds) : 
-        contract(receiver, code, ds), _config(std::make_shared<config_wrapper>(get_self())) {}
+        contract(receiver, code, ds), _config{get_self()} {}
+
+config_wrapper* evm_contract::lazy_config::operator->() {
+    if (!wrapper) {
+        wrapper = std::make_shared<config_wrapper>(self);
+    }
+    return wrapper.get();
+}
 
 void evm_contract::assert_inited()
 {
@@ -130,6 +145,32 @@ void evm_contract::freeze(bool value) {
     _config->set_status(status);
 }
 
+void evm_contract::compactevmtx(bool value) {
+    eosio::require_auth(get_self());
+
+    assert_inited();
+    auto status = _config->get_status();
+    if (value) {
+        status |= static_cast<uint32_t>(status_flags::compact_evmtx);
+    } else {
+        status &= ~static_cast<uint32_t>(status_flags::compact_evmtx);
+    }
+    _config->set_status(status);
+}
+
+void evm_contract::fastdeposit(bool value) {
+    eosio::require_auth(get_self());
+
+    assert_inited();
+    auto status = _config->get_status();
+    if (value) {
+        status |= static_cast<uint32_t>(status_flags::fast_deposit);
+    } else {
+        status &= ~static_cast<uint32_t>(status_flags::fast_deposit);
+    }
+    _config->set_status(status);
+}
+
 void check_result( ValidationResult r, const Transaction& txn, const char* desc ) {
     if( r == ValidationResult::kOk )
         return;
@@ -180,6 +221,61 @@ void check_result( ValidationResult r, const Transaction& txn, const char* desc
     eosio::check( false, std::move(err_msg));
 }
 
+// Flattens the consensus parameters once per action. The interpreter still reads them, and checks the EOS EVM
+// version, inside the SSTORE/CREATE/CALL instruction bodies; specializing those per version would mean carrying a
+// second copy of evmone's instruction table that every consensus change has to be mirrored into.
+evmone::gas_parameters make_gas_parameters(const consensus_parameter_data_type& consensus_param) {
+    return std::visit([&](const auto &v) {
+        return evmone::gas_parameters(
+            v.gas_parameter.gas_txnewaccount,
+            v.gas_parameter.gas_newaccount,
+            v.gas_parameter.gas_txcreate,
+            v.gas_parameter.gas_codedeposit,
+            v.gas_parameter.gas_sset
+        );
+    }, consensus_param);
+}
+
+// A plain value transfer to an existing account without code: no data, no access list and
+// no reserved or precompile target. It doesn't need the interpreter.
+bool is_plain_transfer(const Transaction& tx, silkworm::ExecutionProcessor& ep) {
+    if (!tx.to || !tx.data.empty() || !tx.access_list.empty())
+        return false;
+    const evmc::address& to = *tx.to;
+    if (is_reserved_address(to) || silkworm::precompile::is_precompile(to, ep.evm().revision()))
+        return false;
+    return !ep.state().is_dead(to) && ep.state().get_code_hash(to) == kEmptyHash;
+}
+
+// Same state changes and receipt as ExecutionProcessor::execute_transaction for a plain transfer
+void execute_plain_transfer(const Transaction& tx, Receipt& receipt, silkworm::ExecutionProcessor& ep) {
+    auto& state = ep.state();
+    auto& evm = ep.evm();
+
+    state.clear_journal_and_substate();
+
+    const intx::uint256 base_fee_per_gas{evm.block().header.base_fee_per_gas.value_or(0)};
+    const intx::uint256 gas_fee{intx::uint256{protocol::fee::kGTransaction} * tx.effective_gas_price(base_fee_per_gas)};
+
+    state.subtract_from_balance(*tx.from, gas_fee);
+    state.set_nonce(*tx.from, tx.nonce + 1);
+
+    state.subtract_from_balance(*tx.from, tx.value);
+    state.add_to_balance(*tx.to, tx.value);
+
+    state.add_to_balance(evm.beneficiary, gas_fee);
+
+    if (evm.revision() >= EVMC_SPURIOUS_DRAGON)
+        state.destruct_touched_dead();
+    state.finalize_transaction();
+
+    receipt.type = tx.type;
+    receipt.success = true;
+    receipt.cumulative_gas_used = protocol::fee::kGTransaction;
+    receipt.bloom = logs_bloom(state.logs());
+    receipt.logs.clear();
+}
+
 Receipt evm_contract::execute_tx(const runtime_config& rc, eosio::name miner, Block& block, const transaction& txn, silkworm::ExecutionProcessor& ep) {
     const auto& tx = txn.get_tx();
     balances balance_table(get_self(), get_self().value);
@@ -218,9 +314,10 @@ Receipt evm_contract::execute_tx(const runtime_config& rc, eosio::name miner, Bl
         if (is_reserved_address(*tx.from)) {
             const name ingress_account(*extract_reserved_address(*tx.from));
 
-            const intx::uint512 max_gas_cost = intx::uint256(tx.gas_limit) * tx.max_fee_per_gas;
-            check(max_gas_cost + tx.value < std::numeric_limits<intx::uint256>::max(), "too much gas");
-            const intx::uint256 value_with_max_gas = tx.value + (intx::uint256)max_gas_cost;
+            intx::uint256 max_gas_cost;
+            check(checked_mul(tx.gas_limit, tx.max_fee_per_gas, max_gas_cost), "too much gas");
+            const intx::uint256 value_with_max_gas = tx.value + max_gas_cost;
+            check(value_with_max_gas >= max_gas_cost && value_with_max_gas < std::numeric_limits<intx::uint256>::max(), "too much gas");
 
             populate_bridge_accessors();
             balance_table.modify(balance_table.get(ingress_account.value), eosio::same_payer, [&](balance& b){
@@ -247,24 +344,31 @@ Receipt evm_contract::execute_tx(const runtime_config& rc, eosio::name miner, Bl
     r = silkworm::protocol::validate_transaction(tx, ep.state(), ep.available_gas());
     check_result( r, tx, "validate_transaction error" );
 
+    // The version is fixed in the block header for the whole transaction
+    const uint64_t evm_version = ep.evm().get_eos_evm_version();
+
     Receipt receipt;
-    ep.execute_transaction(tx, receipt);
+    if (!is_special_signature && evm_version < 3 && is_plain_transfer(tx, ep)) {
+        execute_plain_transfer(tx, receipt, ep);
+    } else {
+        ep.execute_transaction(tx, receipt);
+    }
 
     // Calculate the miner portion of the actual gas fee (if necessary):
     std::optional<intx::uint256> gas_fee_miner_portion;
     if (miner) {
         uint64_t tx_gas_used = receipt.cumulative_gas_used; // Only transaction in the "block" so cumulative_gas_used is the tx gas_used.
-        if(_config->get_evm_version() >= 1) {
+        if(evm_version >= 1) {
             eosio::check(ep.evm().block().header.base_fee_per_gas.has_value(), "no base fee");
-            intx::uint512 gas_fee = intx::uint256(tx_gas_used) * tx.priority_fee_per_gas(ep.evm().block().header.base_fee_per_gas.value());
-            check(gas_fee < std::numeric_limits<intx::uint256>::max(), "too much gas");
-            gas_fee_miner_portion.emplace(static_cast<intx::uint256>(gas_fee));
+            intx::uint256 gas_fee;
+            check(checked_mul(tx_gas_used, tx.priority_fee_per_gas(ep.evm().block().header.base_fee_per_gas.value()), gas_fee) &&
+                  gas_fee < std::numeric_limits<intx::uint256>::max(), "too much gas");
+            gas_fee_miner_portion.emplace(gas_fee);
         } else {
-            intx::uint512 gas_fee = intx::uint256(tx_gas_used) * tx.max_fee_per_gas;
-            check(gas_fee < std::numeric_limits<intx::uint256>::max(), "too much gas");
-            gas_fee *= _config->get_miner_cut();
-            gas_fee /= hundred_percent;
-            gas_fee_miner_portion.emplace(static_cast<intx::uint256>(gas_fee));
+            intx::uint256 gas_fee;
+            check(checked_mul(tx_gas_used, tx.max_fee_per_gas, gas_fee) &&
+                  gas_fee < std::numeric_limits<intx::uint256>::max(), "too much gas");
+            gas_fee_miner_portion.emplace(mul_hundred_percent(gas_fee, _config->get_miner_cut()));
         }
     }
 
@@ -351,24 +455,20 @@ void evm_contract::exec(const exec_input& input, const std::optional<exec_callba
         base_fee_per_gas = _config->get_gas_price();
     }
     eosevm::prepare_block_header(block.header, bm, get_self().value,
-        bm.timestamp_to_evm_block_num(eosio::current_time_point().time_since_epoch().count()), evm_version, base_fee_per_gas);
+        timestamp_to_evm_block_num(_config->get_genesis_time(), eosio::current_time_point()), evm_version, base_fee_per_gas);
 
     evm_runtime::state state{get_self(), get_self(), true};
     IntraBlockState ibstate{state};
 
     const auto& consensus_param = _config->get_consensus_param();
 
-    auto gas_params = std::visit([&](const auto &v) {
-        return evmone::gas_parameters(
-            v.gas_parameter.gas_txnewaccount,
-            v.gas_parameter.gas_newaccount,
-            v.gas_parameter.gas_txcreate,
-            v.gas_parameter.gas_codedeposit,
-            v.gas_parameter.gas_sset
-        );
-    }, consensus_param);
+    auto gas_params = make_gas_parameters(consensus_param);
 
     EVM evm{block, ibstate, *found_chain_config.value().second, gas_params};
+#ifdef WITH_FUSION_STATS
+    fusion_stats_tracer fusion_stats;
+    evm.add_tracer(fusion_stats);
+#endif
 
     Transaction txn;
     txn.to    = to_address(input.to);
@@ -377,6 +477,9 @@ void evm_contract::exec(const exec_input& input, const std::optional<exec_callba
     txn.value = input.value.has_value() ? to_uint256(input.value.value()) : 0;
 
     const CallResult vm_res{evm.execute(txn, 0x7ffffffffff)};
+#ifdef WITH_FUSION_STATS
+    fusion_stats.print();
+#endif
 
     exec_output output{
         .status  = int32_t(vm_res.status),
@@ -449,7 +552,7 @@ void evm_contract::process_filtered_messages(const std::vector<silkworm::Filtere
 
 }
 
-void evm_contract::process_tx(const runtime_config& rc, eosio::name miner, const transaction& txn, std::optional<uint64_t> min_inclusion_price) {
+void evm_contract::process_tx(const runtime_config& rc, eosio::name miner, const transaction& txn, std::optional<uint64_t> min_inclusion_price, std::optional<uint32_t> max_cpu_us) {
     LOGTIME("EVM START1");
 
     const auto& tx = txn.get_tx();
@@ -482,21 +585,13 @@ void evm_contract::process_tx(const runtime_config& rc, eosio::name miner, const
     }
 
     eosevm::prepare_block_header(block.header, bm, get_self().value,
-        bm.timestamp_to_evm_block_num(eosio::current_time_point().time_since_epoch().count()), current_version, base_fee_per_gas);
+        timestamp_to_evm_block_num(_config->get_genesis_time(), eosio::current_time_point()), current_version, base_fee_per_gas);
 
     silkworm::protocol::TrustRuleSet engine{*found_chain_config->second};
 
     evm_runtime::state state{get_self(), get_self(), false, false};
 
-    auto gas_params = std::visit([&](const auto &v) {
-        return evmone::gas_parameters(
-            v.gas_parameter.gas_txnewaccount,
-            v.gas_parameter.gas_newaccount,
-            v.gas_parameter.gas_txcreate,
-            v.gas_parameter.gas_codedeposit,
-            v.gas_parameter.gas_sset
-        );
-    }, gas_param_pair.first);
+    auto gas_params = make_gas_parameters(gas_param_pair.first);
 
     if (current_version >= 1) {
         auto inclusion_price = std::min(tx.max_priority_fee_per_gas, tx.max_fee_per_gas - *base_fee_per_gas);
@@ -515,35 +610,47 @@ void evm_contract::process_tx(const runtime_config& rc, eosio::name miner, const
         return message.recipient == me && message.input_size > 0;
     });
 
+    std::optional<cpu_budget_tracer> cpu_budget;
+    if (max_cpu_us.has_value()) {
+        cpu_cost_model_singleton cpu_model(get_self(), get_self().value);
+        cpu_budget.emplace(*max_cpu_us, cpu_model.get_or_default(), txn.get_rlptx().size());
+        ep.evm().add_tracer(*cpu_budget);
+    }
+
     auto receipt = execute_tx(rc, miner, block, txn, ep);
 
     process_filtered_messages(ep.state().filtered_messages());
 
     engine.finalize(ep.state(), ep.evm().block());
     ep.state().write_to_db(ep.evm().block().header.number);
+    LOGTIME(("EVM STATE ARENA USED " + std::to_string(state._arena.used())).c_str());
 
     if (gas_param_pair.second) {
         configchange_action act{get_self(), std::vector<eosio::permission_level>()};
         act.send(gas_param_pair.first);
     }
 
-    if(current_version >= 3) {
-        auto event = evmtx_type{evmtx_v3{current_version, txn.get_rlptx(), gas_prices.overhead_price, gas_prices.storage_price}};
-        action(std::vector<permission_level>{}, get_self(), "evmtx"_n, event).send();
-    } else if (current_version >= 1) {
-        auto event = evmtx_type{evmtx_v1{current_version, txn.get_rlptx(), *base_fee_per_gas}};
-        action(std::vector<permission_level>{}, get_self(), "evmtx"_n, event).send();
+    if(current_version >= 1) {
+        if(rc.rlptx_in_parent_action && (_config->get_status() & static_cast<uint32_t>(status_flags::compact_evmtx))) {
+            // The rlptx is already in the pushtx action data, don't send it a second time.
+            auto event = evmtx_type{evmtx_compact{current_version, 0, base_fee_per_gas.value_or(0), gas_prices.overhead_price, gas_prices.storage_price}};
+            action(std::vector<permission_level>{}, get_self(), "evmtx"_n, event).send();
+            LOGTIME("EVM END");
+            return;
+        }
+        auto rlptx = txn.get_rlptx();
+        if(current_version >= 3) {
+            auto event = evmtx_type{evmtx_v3{current_version, bytes{rlptx.begin(), rlptx.end()}, gas_prices.overhead_price, gas_prices.storage_price}};
+            action(std::vector<permission_level>{}, get_self(), "evmtx"_n, event).send();
+        } else {
+            auto event = evmtx_type{evmtx_v1{current_version, bytes{rlptx.begin(), rlptx.end()}, *base_fee_per_gas}};
+            action(std::vector<permission_level>{}, get_self(), "evmtx"_n, event).send();
+        }
     }
     LOGTIME("EVM END");
 }
 
-void evm_contract::pushtx(eosio::name miner, bytes rlptx, eosio::binary_extension<uint64_t> min_inclusion_price) {
-    LOGTIME("EVM START0");
-    assert_unfrozen();
-
-    auto evm_version = _config->get_evm_version();
-    if (evm_version >= 1) _config->process_price_queue();
-
+runtime_config evm_contract::pushtx_runtime_config() {
     // Use default runtime configuration parameters.
     runtime_config rc;
 
@@ -566,14 +673,138 @@ void evm_contract::pushtx(eosio::name miner, bytes rlptx, eosio::binary_extensio
         rc.enforce_chain_id = false;
         rc.allow_non_self_miner = false;
     }
+    return rc;
+}
+
+void evm_contract::pushtx(eosio::name miner, eosio::ignore<bytes> rlptx, eosio::ignore<eosio::binary_extension<uint64_t>> min_inclusion_price, eosio::ignore<eosio::binary_extension<uint32_t>> max_cpu_us) {
+    LOGTIME("EVM START0");
+    assert_unfrozen();
+
+    // rlptx and the optional arguments are read straight from the action data. The action data buffer lives for the
+    // whole action, so the transaction is decoded in place instead of being copied into a `bytes` argument first.
+    auto& ds = get_datastream();
+    eosio::unsigned_int rlptx_size;
+    ds >> rlptx_size;
+    eosio::check(rlptx_size.value <= ds.remaining(), "invalid rlptx");
+    ByteView rlptx_view{(const uint8_t*)ds.pos(), rlptx_size.value};
+    ds.skip(rlptx_size.value);
+
+    auto evm_version = _config->get_evm_version();
+    if (evm_version >= 1) _config->process_price_queue();
+
+    runtime_config rc = pushtx_runtime_config();
+    rc.rlptx_in_parent_action = true;
 
     std::optional<uint64_t> min_inclusion_price_;
-    if (min_inclusion_price.has_value()) {
-        min_inclusion_price_ = *min_inclusion_price;
+    if (ds.remaining()) {
+        uint64_t price;
+        ds >> price;
+        min_inclusion_price_ = price;
         check(evm_version >= 1, "min_inclusion_price requires evm_version >= 1");
     }
 
-    process_tx(rc, miner, transaction{std::move(rlptx)}, min_inclusion_price_);
+    std::optional<uint32_t> max_cpu_us_;
+    if (ds.remaining()) {
+        uint32_t budget;
+        ds >> budget;
+        max_cpu_us_ = budget;
+    }
+
+    process_tx(rc, miner, transaction{rlptx_view}, min_inclusion_price_, max_cpu_us_);
+}
+
+void evm_contract::stagechunk(eosio::name miner, const bytes& chunk) {
+    assert_unfrozen();
+    require_auth(miner);
+    eosio::check(_config->get_evm_version() >= 1, "staged transactions require evm_version >= 1");
+
+    staged_tx_table staged(get_self(), miner.value);
+    eosio::check(staged.find(0) == staged.end(), "staged transaction already committed");
+
+    // One row per chunk, so each upload only writes its own chunk
+    staged_chunk_table chunks(get_self(), miner.value);
+    const uint64_t seq = chunks.begin() == chunks.end() ? 0 : chunks.rbegin()->seq + 1;
+    chunks.emplace(miner, [&](auto& row) {
+        row.seq = seq;
+        row.data = chunk;
+    });
+}
+
+void evm_contract::stagecommit(eosio::name miner) {
+    assert_unfrozen();
+    require_auth(miner);
+    eosio::check(_config->get_evm_version() >= 1, "staged transactions require evm_version >= 1");
+
+    staged_tx_table staged(get_self(), miner.value);
+    eosio::check(staged.find(0) == staged.end(), "staged transaction already committed");
+
+    staged_chunk_table chunks(get_self(), miner.value);
+    eosio::check(chunks.begin() != chunks.end(), "no staged transaction");
+
+    bytes rlptx;
+    for (auto itr = chunks.begin(); itr != chunks.end(); ) {
+        rlptx.insert(rlptx.end(), itr->data.begin(), itr->data.end());
+        itr = chunks.erase(itr);
+    }
+
+    // Decode and recover the sender here, pushstaged only executes
+    transaction txn{ByteView{(const uint8_t*)rlptx.data(), rlptx.size()}};
+    const auto& tx = txn.get_tx();
+    txn.recover_sender();
+    eosio::check(tx.from.has_value(), "unable to recover sender");
+
+    const auto hash = ethash::keccak256(reinterpret_cast<const uint8_t*>(rlptx.data()), rlptx.size());
+    staged.emplace(miner, [&](auto& row) {
+        row.hash.assign(std::begin(hash.bytes), std::end(hash.bytes));
+        row.sender = to_bytes(*tx.from);
+        row.rlptx = std::move(rlptx);
+    });
+}
+
+void evm_contract::pushstaged(eosio::name miner, const bytes& hash, const eosio::binary_extension<uint64_t>& min_inclusion_price, const eosio::binary_extension<uint32_t>& max_cpu_us) {
+    LOGTIME("EVM START0");
+    assert_unfrozen();
+    require_auth(miner);
+    // Without the evmtx event (evm_version 0) EVM nodes rebuild transactions from pushtx action data only.
+    eosio::check(_config->get_evm_version() >= 1, "staged transactions require evm_version >= 1");
+
+    staged_tx_table staged(get_self(), miner.value);
+    auto itr = staged.find(0);
+    if (itr == staged.end()) {
+        staged_chunk_table chunks(get_self(), miner.value);
+        eosio::check(chunks.begin() == chunks.end(), "staged transaction not committed");
+        eosio::check(false, "no staged transaction");
+    }
+    const auto& row = *itr;
+    eosio::check(row.hash == hash, "staged transaction hash mismatch");
+
+    _config->process_price_queue();
+
+    // The rlptx is not part of this action's data, so the evmtx event always carries it.
+    runtime_config rc = pushtx_runtime_config();
+
+    std::optional<uint64_t> min_inclusion_price_;
+    if (min_inclusion_price.has_value()) min_inclusion_price_ = min_inclusion_price.value();
+    std::optional<uint32_t> max_cpu_us_;
+    if (max_cpu_us.has_value()) max_cpu_us_ = max_cpu_us.value();
+
+    process_tx(rc, miner, transaction{ByteView{(const uint8_t*)row.rlptx.data(), row.rlptx.size()}, to_address(row.sender)}, min_inclusion_price_, max_cpu_us_);
+    staged.erase(row);
+}
+
+void evm_contract::stagereset(eosio::name miner) {
+    require_auth(miner);
+
+    staged_chunk_table chunks(get_self(), miner.value);
+    for (auto itr = chunks.begin(); itr != chunks.end(); ) {
+        itr = chunks.erase(itr);
+    }
+
+    staged_tx_table staged(get_self(), miner.value);
+    auto itr = staged.find(0);
+    if (itr != staged.end()) {
+        staged.erase(itr);
+    }
 }
 
 void evm_contract::open(eosio::name owner) {
@@ -666,27 +897,67 @@ void evm_contract::handle_evm_transfer(eosio::asset quantity, const std::string&
     intx::uint256 value((uint64_t)quantity.amount);
     value *= intx::uint256(_config->get_minimum_natively_representable());
 
-    auto calculate_gas_limit = [&](const evmc::address& destination) -> int64_t {
-        int64_t gas_limit = 21000;
+    const evmc::address destination = to_evmc_address(*address_bytes);
+
+    account_table accounts(get_self(), get_self().value);
+    auto inx = accounts.get_index<"by.address"_n>();
+    auto itr = inx.find(make_key(destination));
+
+    // A deposit to an existing account without code is just a balance credit. With fast deposits enabled
+    // the account is credited directly and EVM nodes replay the equivalent bridge transaction from the event.
+    const auto evm_version = _config->get_evm_version_and_maybe_promote();
+    if (evm_version >= 1 && evm_version < 3 &&
+        (_config->get_status() & static_cast<uint32_t>(status_flags::fast_deposit)) &&
+        itr != inx.end() && !itr->code_id &&
+        !is_reserved_address(destination) && !silkworm::precompile::is_precompile(destination, EVMC_MAX_REVISION)) {
+
+        check(!itr->has_flag(account::flag::frozen), "account is frozen");
 
-        account_table accounts(get_self(), get_self().value);
-        auto inx = accounts.get_index<"by.address"_n>();
-        auto itr = inx.find(make_key(destination));
+        auto gas_param_pair = _config->get_consensus_param_and_maybe_promote();
 
-        if(itr == inx.end()) {
-            gas_limit += std::visit([&](const auto &v) { return v.gas_parameter.gas_txnewaccount; }, _config->get_consensus_param());
+        inx.modify(itr, eosio::same_payer, [&](account& a){
+            a.balance = to_bytes(to_uint256(a.balance) + value);
+        });
+        balance_table.modify(balance_table.get(get_self().value), eosio::same_payer, [&](balance& b){
+            b.balance -= value;
+        });
+        inevm_singleton inevm(get_self(), get_self().value);
+        inevm.set(inevm.get() += value, eosio::same_payer);
+
+        const uint64_t nonce = get_and_increment_nonce(get_self());
+
+        // Leave the reserved sender exactly as the bridge transaction would: nonce bumped, and holding
+        // the 21000 gas fee it receives back as the block beneficiary.
+        const evmc::address sender = make_reserved_address(get_self().value);
+        evm_runtime::state state{get_self(), get_self()};
+        const std::optional<Account> initial = state.read_account(sender);
+        Account current = initial.value_or(Account{});
+        current.nonce = nonce + 1;
+        current.balance = intx::uint256{protocol::fee::kGTransaction} * _config->get_gas_price();
+        state.update_account(sender, initial, current);
+
+        if (gas_param_pair.second) {
+            configchange_action act{get_self(), std::vector<eosio::permission_level>()};
+            act.send(gas_param_pair.first);
         }
 
-        return gas_limit;
-    };
+        auto event = evmtx_type{evmtx_deposit{evm_version, nonce, _config->get_gas_price(), to_bytes(destination), to_bytes(value)}};
+        action(std::vector<permission_level>{}, get_self(), "evmtx"_n, event).send();
+        return;
+    }
+
+    int64_t gas_limit = 21000;
+    if(itr == inx.end()) {
+        gas_limit += std::visit([&](const auto &v) { return v.gas_parameter.gas_txnewaccount; }, _config->get_consensus_param());
+    }
 
     Transaction txn;
     txn.type = TransactionType::kLegacy;
     txn.nonce = get_and_increment_nonce(get_self());
     txn.max_priority_fee_per_gas = _config->get_gas_price();
     txn.max_fee_per_gas = _config->get_gas_price();
-    txn.to = to_evmc_address(*address_bytes);
-    txn.gas_limit = calculate_gas_limit(*txn.to);
+    txn.to = destination;
+    txn.gas_limit = gas_limit;
     txn.value = value;
     txn.r = 0u;  // r == 0 is pseudo signature that resolves to reserved address range
     txn.s = get_self().value;
@@ -701,12 +972,13 @@ void evm_contract::handle_evm_transfer(eosio::asset quantity, const std::string&
 }
 
 void evm_contract::transfer(eosio::name from, eosio::name to, eosio::asset quantity, std::string memo) {
-    assert_unfrozen();
-    
-    // Allow transfer non-EOS tokens out.
+    // Allow transfer non-EOS tokens out. Notifications of tokens leaving the contract return before the
+    // config is loaded; the actions sending them (withdraw, bridge egress) check the frozen flag themselves.
     if(to != get_self() || from == get_self())
         return;
 
+    assert_unfrozen();
+
     eosio::check(get_code() == _config->get_token_contract() && quantity.symbol == _config->get_token_symbol(), "received unexpected token");
 
     if(memo.size() == 42 && memo[0] == '0' && memo[1] == 'x')
@@ -769,8 +1041,9 @@ void evm_contract::dispatch_tx(const runtime_config& rc, const transaction& tx)
         process_tx(rc, get_self(), tx, {} /* min_inclusion_price */);
     } else {
         eosio::check(rc.allow_special_signature && rc.abort_on_failure && !rc.enforce_chain_id && !rc.allow_non_self_miner, "invalid runtime config");
+        auto rlptx = tx.get_rlptx();
         action(permission_level{get_self(),"active"_n}, get_self(), "pushtx"_n,
-            std::tuple<eosio::name, bytes>(get_self(), tx.get_rlptx())
+            std::tuple<eosio::name, bytes>(get_self(), bytes{rlptx.begin(), rlptx.end()})
         ).send();
     }
 }
@@ -906,6 +1179,14 @@ void evm_contract::setgasparam(uint64_t gas_txnewaccount,
                                 gas_sset);
 }
 
+void evm_contract::setcpumodel(const cpu_cost_model& model) {
+    require_auth(get_self());
+    assert_inited();
+
+    cpu_cost_model_singleton cpu_model(get_self(), get_self().value);
+    cpu_model.set(model, get_self());
+}
+
 void evm_contract::setgasprices(const gas_prices_type& prices) {
     require_auth(get_self());
     auto current_version = _config->get_evm_version_and_maybe_promote();
@@ -106,8 +106,7 @@ void config_wrapper::enqueue(Func&& update_fnc) {
     Q queue(_self, _self.value);
     auto activation_time = get_current_time() + eosio::seconds(grace_period_seconds);
 
-    eosevm::block_mapping bm(get_genesis_time().sec_since_epoch());
-    auto activation_block_num = bm.timestamp_to_evm_block_num(activation_time.time_since_epoch().count()) + 1;
+    auto activation_block_num = timestamp_to_evm_block_num(get_genesis_time(), activation_time) + 1;
 
     auto it = queue.end();
     if( it != queue.begin()) {
@@ -163,8 +162,7 @@ void config_wrapper::process_price_queue() {
 
 template <typename Q, typename Func>
 void config_wrapper::process_queue(Func&& update_func) {
-    eosevm::block_mapping bm(get_genesis_time().sec_since_epoch());
-    auto current_block_num = bm.timestamp_to_evm_block_num(get_current_time().time_since_epoch().count());
+    auto current_block_num = timestamp_to_evm_block_num(get_genesis_time(), get_current_time());
 
     auto queue_front_block = _cached_config.queue_front_block.value();
     if( queue_front_block == 0 || current_block_num < queue_front_block ) {
@@ -277,20 +275,26 @@ void config_wrapper::update_consensus_parameters(eosio::asset ram_price_mb, uint
     eosio::check(miner_cut < hundred_percent, "100% miner cut is not allowed");
 
     constexpr uint64_t overflow_limit = (1ull << 63) - 1;
+    constexpr uint64_t bytes_per_mb = 1024 * 1024;
 
-    eosio::check((double)overflow_limit/get_minimum_natively_representable() > ram_price_mb.amount / (1024.0 * 1024.0), too_big_str);
+    eosio::check(ram_price_mb.amount >= 0, "gas_per_byte must >= 0");
 
-    double gas_per_byte_f = (ram_price_mb.amount / (1024.0 * 1024.0) * get_minimum_natively_representable()) / (gas_price * static_cast<double>(hundred_percent - miner_cut) / hundred_percent);
+    // gas_per_byte = floor(ram_price_mb * minimum_natively_representable / bytes_per_mb / (gas_price * (1 - miner_cut))) + 1
+    // Evaluated in integers so it does not go through softfloat in the contract.
+    const intx::uint256 ram_price = intx::uint256{static_cast<uint64_t>(ram_price_mb.amount)} * get_minimum_natively_representable();
+    eosio::check(intx::uint256{overflow_limit} * bytes_per_mb > ram_price, too_big_str);
+
+    const intx::uint256 divisor = intx::uint256{bytes_per_mb} * gas_price * (hundred_percent - miner_cut);
+    const intx::uint256 gas_per_byte_256 = ram_price * hundred_percent / divisor + 1;
+    eosio::check(gas_per_byte_256 <= overflow_limit, too_big_str);
 
     constexpr uint64_t account_bytes = 347;
     constexpr uint64_t contract_fixed_bytes = 606;
     constexpr uint64_t storage_slot_bytes = 346;
 
-    eosio::check(gas_per_byte_f >= 0.0, "gas_per_byte must >= 0");
-
-    uint64_t gas_per_byte = (uint64_t)(gas_per_byte_f + 1.0);
+    uint64_t gas_per_byte = static_cast<uint64_t>(gas_per_byte_256);
 
-    eosio::check((double)overflow_limit/gas_per_byte > contract_fixed_bytes, too_big_str);
+    eosio::check(overflow_limit / gas_per_byte > contract_fixed_bytes, too_big_str);
     eosio::check(check_gas_overflow(gas_per_byte * contract_fixed_bytes, gas_per_byte), too_big_str);
 
     this->update_consensus_parameters2(account_bytes * gas_per_byte, /* gas_txnewaccount */
@@ -0,0 +1,32 @@
+// Replacement for silkworm/core/crypto/ecdsa.c in the contract build.
+//
+// silkworm_recover_address is used by Transaction::recover_sender and by the ECRECOVER precompile.
+// Here it is defined directly on top of the k1_recover host function, so recovery no longer depends on
+// how silkworm's ecdsa.c is configured for the contract build. The contract did not link libsecp256k1
+// before either; no size or CPU difference from ecdsa.c has been measured.
+// Range and low-s checks of (r, s) stay in silkworm (is_valid_signature) and are not affected.
+
+#include <cstring>
+
+#include <eosio/crypto_ext.hpp>
+#include <ethash/keccak.hpp>
+#include <silkworm/core/crypto/ecdsa.h>
+
+extern "C" bool silkworm_recover_address(uint8_t out[20], const uint8_t message[32], const uint8_t signature[64],
+                                         bool odd_y_parity, secp256k1_context*) {
+    // k1_recover expects a 65 byte compact signature whose first byte is 27 + recovery id
+    char sig[65];
+    sig[0] = static_cast<char>(27 + (odd_y_parity ? 1 : 0));
+    std::memcpy(sig + 1, signature, 64);
+
+    // uncompressed public key: 0x04 || x || y
+    char public_key[65];
+    if (eosio::internal_use_do_not_use::k1_recover(sig, sizeof(sig), reinterpret_cast<const char*>(message), 32,
+                                                    public_key, sizeof(public_key)) != 0) {
+        return false;
+    }
+
+    const auto hash = ethash::keccak256(reinterpret_cast<const uint8_t*>(public_key) + 1, 64);
+    std::memcpy(out, hash.bytes + 12, 20);
+    return true;
+}
@@ -0,0 +1,121 @@
+// Replacement for ethash/lib/keccak/keccak.c in the contract build.
+//
+// Keccak-256 is by far the most used hash function by silkworm and evmone (KECCAK256 opcode, contract
+// addresses, code hashes, storage keys), so it is computed by the `sha3` host function in keccak mode
+// instead of being interpreted as WASM. The remaining entry points are only needed by ethash and are
+// kept as a compact portable implementation.
+
+#include <cstring>
+
+#include <eosio/crypto_ext.hpp>
+#include <ethash/keccak.h>
+
+namespace {
+
+constexpr uint64_t round_constants[24] = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000,
+    0x000000000000808b, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+    0x000000000000008a, 0x0000000000000088, 0x0000000080008009, 0x000000008000000a,
+    0x000000008000808b, 0x800000000000008b, 0x8000000000008089, 0x8000000000008003,
+    0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008,
+};
+
+constexpr int rotations[24] = {
+    1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14, 27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44,
+};
+
+constexpr int pi_lanes[24] = {
+    10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1,
+};
+
+inline uint64_t rol(uint64_t x, int s) { return (x << s) | (x >> (64 - s)); }
+
+// WASM is little endian, so the state can be absorbed and squeezed byte by byte.
+template <size_t Bits>
+void keccak(uint8_t* out, const uint8_t* data, size_t size) {
+    constexpr size_t rate = 200 - 2 * Bits / 8;
+
+    uint64_t st[25] = {};
+    auto* st_bytes = reinterpret_cast<uint8_t*>(st);
+
+    while (size >= rate) {
+        for (size_t i = 0; i < rate; ++i) st_bytes[i] ^= data[i];
+        ethash_keccakf1600(st);
+        data += rate;
+        size -= rate;
+    }
+
+    for (size_t i = 0; i < size; ++i) st_bytes[i] ^= data[i];
+    st_bytes[size] ^= 0x01;
+    st_bytes[rate - 1] ^= 0x80;
+    ethash_keccakf1600(st);
+
+    std::memcpy(out, st, Bits / 8);
+}
+
+inline void host_keccak256(uint8_t* out, const uint8_t* data, size_t size) {
+    eosio::internal_use_do_not_use::sha3(reinterpret_cast<const char*>(data), size,
+                                         reinterpret_cast<char*>(out), 32, 1 /* keccak */);
+}
+
+}  // namespace
+
+extern "C" {
+
+void ethash_keccakf1600(uint64_t state[25]) noexcept {
+    uint64_t bc[5];
+    for (int round = 0; round < 24; ++round) {
+        // Theta
+        for (int i = 0; i < 5; ++i)
+            bc[i] = state[i] ^ state[i + 5] ^ state[i + 10] ^ state[i + 15] ^ state[i + 20];
+        for (int i = 0; i < 5; ++i) {
+            uint64_t t = bc[(i + 4) % 5] ^ rol(bc[(i + 1) % 5], 1);
+            for (int j = 0; j < 25; j += 5) state[j + i] ^= t;
+        }
+
+        // Rho and Pi
+        uint64_t t = state[1];
+        for (int i = 0; i < 24; ++i) {
+            int j = pi_lanes[i];
+            bc[0] = state[j];
+            state[j] = rol(t, rotations[i]);
+            t = bc[0];
+        }
+
+        // Chi
+        for (int j = 0; j < 25; j += 5) {
+            for (int i = 0; i < 5; ++i) bc[i] = state[j + i];
+            for (int i = 0; i < 5; ++i) state[j + i] ^= (~bc[(i + 1) % 5]) & bc[(i + 2) % 5];
+        }
+
+        // Iota
+        state[0] ^= round_constants[round];
+    }
+}
+
+union ethash_hash256 ethash_keccak256(const uint8_t* data, size_t size) noexcept {
+    union ethash_hash256 hash;
+    host_keccak256(hash.bytes, data, size);
+    return hash;
+}
+
+union ethash_hash256 ethash_keccak256_32(const uint8_t data[32]) noexcept {
+    union ethash_hash256 hash;
+    host_keccak256(hash.bytes, data, 32);
+    return hash;
+}
+
+union ethash_hash512 ethash_keccak512(const uint8_t* data, size_t size) noexcept {
+    union ethash_hash512 hash;
+    keccak<512>(hash.bytes, data, size);
+    return hash;
+}
+
+union ethash_hash512 ethash_keccak512_64(const uint8_t data[64]) noexcept {
+    union ethash_hash512 hash;
+    keccak<512>(hash.bytes, data, 64);
+    return hash;
+}
+
+}  // extern "C"
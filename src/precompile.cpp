@@ -0,0 +1,65 @@
+// Replacement for silkworm/core/execution/precompile.cpp in the contract build.
+//
+// Gas rules follow silkworm (and the yellow paper / EIPs) exactly; the heavy lifting of each
+// precompile is done by Antelope host functions instead of portable WASM code. This file has
+// ECRECOVER, IDENTITY and the precompile lookup; the others are in precompile_hash.cpp (SHA256,
+// RIPEMD160), precompile_expmod.cpp, precompile_bn254.cpp and precompile_blake2.cpp.
+
+#include <algorithm>
+
+#include <intx/intx.hpp>
+
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/crypto/ecdsa.h>
+#include <silkworm/core/crypto/secp256k1n.hpp>
+#include <silkworm/core/execution/precompile.hpp>
+
+#include "precompile_common.hpp"
+
+namespace silkworm::precompile {
+
+using namespace detail;
+
+uint64_t ecrec_gas(ByteView, evmc_revision) noexcept { return 3'000; }
+
+std::optional<Bytes> ecrec_run(ByteView input) noexcept {
+    const Bytes d{right_padded(input, 128)};
+
+    const auto v{intx::be::unsafe::load<intx::uint256>(&d[32])};
+    const auto r{intx::be::unsafe::load<intx::uint256>(&d[64])};
+    const auto s{intx::be::unsafe::load<intx::uint256>(&d[96])};
+
+    // The precompile accepts high-s signatures (no homestead rule)
+    if ((v != 27 && v != 28) || !is_valid_signature(r, s, /*homestead=*/false)) {
+        return Bytes{};
+    }
+
+    Bytes out(32, '\0');
+    if (!silkworm_recover_address(&out[12], &d[0], &d[64], v != 27, nullptr)) {
+        return Bytes{};
+    }
+    return out;
+}
+
+uint64_t id_gas(ByteView input, evmc_revision) noexcept { return 15 + 3 * words(input); }
+
+std::optional<Bytes> id_run(ByteView input) noexcept { return Bytes{input}; }
+
+bool is_precompile(const evmc::address& address, evmc_revision rev) noexcept {
+    static_assert(std::size(kContracts) < 256);
+
+    for (size_t i{0}; i < kAddressLength - 1; ++i) {
+        if (address.bytes[i] != 0) {
+            return false;
+        }
+    }
+
+    const uint8_t num{address.bytes[kAddressLength - 1]};
+    if (num >= std::size(kContracts) || !kContracts[num]) {
+        return false;
+    }
+
+    return kContracts[num]->added_in <= rev;
+}
+
+}  // namespace silkworm::precompile
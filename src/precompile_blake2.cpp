@@ -0,0 +1,43 @@
+// BLAKE2F precompile (0x09, EIP-152) of the contract build, computed by the blake2_f host function.
+
+#include <eosio/crypto_ext.hpp>
+
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/execution/precompile.hpp>
+
+#include "precompile_common.hpp"
+
+namespace silkworm::precompile {
+
+using namespace detail;
+
+uint64_t blake2_f_gas(ByteView input, evmc_revision) noexcept {
+    if (input.size() < 4) {
+        // blake2_f_run will fail anyway
+        return 0;
+    }
+    return endian::load_big_u32(input.data());
+}
+
+std::optional<Bytes> blake2_f_run(ByteView input) noexcept {
+    // rounds(4) || h(64) || m(128) || t(16) || f(1)
+    if (input.size() != 213) {
+        return std::nullopt;
+    }
+    const uint8_t f{input[212]};
+    if (f != 0 && f != 1) {
+        return std::nullopt;
+    }
+
+    const auto rounds{endian::load_big_u32(input.data())};
+
+    Bytes out(64, '\0');
+    if (eosio::internal_use_do_not_use::blake2_f(rounds, as_chars(&input[4]), 64, as_chars(&input[68]), 128,
+                                                 as_chars(&input[196]), 8, as_chars(&input[204]), 8, f,
+                                                 as_chars(out.data()), out.size()) != 0) {
+        return std::nullopt;
+    }
+    return out;
+}
+
+}  // namespace silkworm::precompile
@@ -0,0 +1,68 @@
+// alt_bn128 precompiles (ecAdd, ecMul and ecPairing, 0x06-0x08) of the contract build, computed by
+// the alt_bn128_add, alt_bn128_mul and alt_bn128_pair host functions.
+
+#include <eosio/crypto_ext.hpp>
+
+#include <silkworm/core/execution/precompile.hpp>
+
+#include "precompile_common.hpp"
+
+namespace silkworm::precompile {
+
+using namespace detail;
+
+uint64_t bn_add_gas(ByteView, evmc_revision rev) noexcept { return rev >= EVMC_ISTANBUL ? 150 : 500; }
+
+std::optional<Bytes> bn_add_run(ByteView input) noexcept {
+    const Bytes d{right_padded(input, 128)};
+
+    Bytes out(64, '\0');
+    if (eosio::internal_use_do_not_use::alt_bn128_add(as_chars(&d[0]), 64, as_chars(&d[64]), 64,
+                                                      as_chars(out.data()), out.size()) != 0) {
+        return std::nullopt;
+    }
+    return out;
+}
+
+uint64_t bn_mul_gas(ByteView, evmc_revision rev) noexcept { return rev >= EVMC_ISTANBUL ? 6'000 : 40'000; }
+
+std::optional<Bytes> bn_mul_run(ByteView input) noexcept {
+    const Bytes d{right_padded(input, 96)};
+
+    Bytes out(64, '\0');
+    if (eosio::internal_use_do_not_use::alt_bn128_mul(as_chars(&d[0]), 64, as_chars(&d[64]), 32,
+                                                      as_chars(out.data()), out.size()) != 0) {
+        return std::nullopt;
+    }
+    return out;
+}
+
+static constexpr size_t kSnarkvStride{192};
+
+uint64_t snarkv_gas(ByteView input, evmc_revision rev) noexcept {
+    const uint64_t k{input.size() / kSnarkvStride};
+    return rev >= EVMC_ISTANBUL ? 34'000 * k + 45'000 : 80'000 * k + 100'000;
+}
+
+std::optional<Bytes> snarkv_run(ByteView input) noexcept {
+    if (input.size() % kSnarkvStride != 0) {
+        return std::nullopt;
+    }
+
+    Bytes out(32, '\0');
+    if (input.empty()) {
+        // The product of an empty set of pairings is one
+        out[31] = 1;
+        return out;
+    }
+
+    // alt_bn128_pair returns 0 if the pairing check holds, 1 if it doesn't and -1 on invalid input
+    const auto res{eosio::internal_use_do_not_use::alt_bn128_pair(as_chars(input.data()), input.size())};
+    if (res < 0) {
+        return std::nullopt;
+    }
+    out[31] = res == 0 ? 1 : 0;
+    return out;
+}
+
+}  // namespace silkworm::precompile
@@ -0,0 +1,31 @@
+#pragma once
+
+// Helpers shared by the precompile replacements (precompile*.cpp) in the contract build.
+
+#include <algorithm>
+
+#include <silkworm/core/common/base.hpp>
+
+namespace silkworm::precompile::detail {
+
+// Copy of input right padded with zeros up to min_size
+inline Bytes right_padded(ByteView input, size_t min_size) {
+    Bytes out{input};
+    if (out.size() < min_size) {
+        out.resize(min_size, '\0');
+    }
+    return out;
+}
+
+inline ByteView without_leading_zeros(ByteView data) {
+    const auto first_nonzero{std::find_if(data.begin(), data.end(), [](uint8_t b) { return b != 0; })};
+    data.remove_prefix(static_cast<size_t>(first_nonzero - data.begin()));
+    return data;
+}
+
+inline uint64_t words(ByteView input) { return (input.size() + 31) / 32; }
+
+inline const char* as_chars(const uint8_t* p) { return reinterpret_cast<const char*>(p); }
+inline char* as_chars(uint8_t* p) { return reinterpret_cast<char*>(p); }
+
+}  // namespace silkworm::precompile::detail
@@ -0,0 +1,143 @@
+// MODEXP precompile (0x05) of the contract build. Gas is EIP-198 before Berlin and EIP-2565 from
+// Berlin on; the exponentiation is done by the mod_exp host function.
+
+#include <algorithm>
+#include <cstring>
+
+#include <eosio/crypto_ext.hpp>
+#include <intx/intx.hpp>
+
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/execution/precompile.hpp>
+
+#include "precompile_common.hpp"
+
+namespace silkworm::precompile {
+
+using namespace detail;
+
+namespace {
+
+intx::uint256 mult_complexity_eip198(const intx::uint256& x) noexcept {
+    const intx::uint256 x_squared{x * x};
+    if (x <= 64) {
+        return x_squared;
+    } else if (x <= 1024) {
+        return (x_squared >> 2) + 96 * x - 3072;
+    } else {
+        return (x_squared >> 4) + 480 * x - 199680;
+    }
+}
+
+intx::uint256 mult_complexity_eip2565(const intx::uint256& max_length) noexcept {
+    const intx::uint256 words{(max_length + 7) >> 3};  // ⌈max_length/8⌉
+    return words * words;
+}
+
+}  // namespace
+
+uint64_t expmod_gas(ByteView input, evmc_revision rev) noexcept {
+    const uint64_t min_gas{rev < EVMC_BERLIN ? 0 : 200u};
+
+    const Bytes d{right_padded(input, 3 * 32)};
+    const auto base_len256{intx::be::unsafe::load<intx::uint256>(&d[0])};
+    const auto exp_len256{intx::be::unsafe::load<intx::uint256>(&d[32])};
+    const auto mod_len256{intx::be::unsafe::load<intx::uint256>(&d[64])};
+
+    if (base_len256 == 0 && mod_len256 == 0) {
+        return min_gas;
+    }
+
+    if (intx::count_significant_words(base_len256) > 1 || intx::count_significant_words(exp_len256) > 1 ||
+        intx::count_significant_words(mod_len256) > 1) {
+        return UINT64_MAX;
+    }
+
+    const auto base_len64{static_cast<uint64_t>(base_len256)};
+    const auto exp_len64{static_cast<uint64_t>(exp_len256)};
+
+    // First (up to) 32 bytes of the exponent
+    intx::uint256 exp_head{0};
+    if (input.size() > 3 * 32 && input.size() - 3 * 32 > base_len64) {
+        input.remove_prefix(3 * 32 + base_len64);
+        const Bytes exp_input{right_padded(input.substr(0, 32), 32)};
+        exp_head = intx::be::unsafe::load<intx::uint256>(exp_input.data());
+        if (exp_len64 < 32) {
+            exp_head >>= 8 * (32 - exp_len64);
+        }
+    }
+
+    const unsigned bit_len{256 - intx::clz(exp_head)};
+
+    intx::uint256 adjusted_exponent_len{0};
+    if (exp_len256 > 32) {
+        adjusted_exponent_len = 8 * (exp_len256 - 32);
+    }
+    if (bit_len > 1) {
+        adjusted_exponent_len += bit_len - 1;
+    }
+    if (adjusted_exponent_len < 1) {
+        adjusted_exponent_len = 1;
+    }
+
+    const intx::uint256 max_length{std::max(mod_len256, base_len256)};
+
+    intx::uint256 gas;
+    if (rev < EVMC_BERLIN) {
+        gas = mult_complexity_eip198(max_length) * adjusted_exponent_len / 20;
+    } else {
+        gas = mult_complexity_eip2565(max_length) * adjusted_exponent_len / 3;
+    }
+
+    if (intx::count_significant_words(gas) > 1) {
+        return UINT64_MAX;
+    }
+    return std::max(min_gas, static_cast<uint64_t>(gas));
+}
+
+std::optional<Bytes> expmod_run(ByteView input) noexcept {
+    const Bytes d{right_padded(input, 3 * 32)};
+    const auto base_len{endian::load_big_u64(&d[24])};
+    const auto exp_len{endian::load_big_u64(&d[56])};
+    const auto mod_len{endian::load_big_u64(&d[88])};
+
+    if (mod_len == 0) {
+        return Bytes{};
+    }
+
+    input.remove_prefix(std::min<size_t>(input.size(), 3 * 32));
+
+    // Each operand is read from the input and right padded with zeros if the input is too short
+    auto operand = [&input](uint64_t len) {
+        Bytes out(len, '\0');
+        const auto n{std::min<uint64_t>(len, input.size())};
+        std::memcpy(out.data(), input.data(), n);
+        input.remove_prefix(n);
+        return out;
+    };
+    const Bytes base{operand(base_len)};
+    const Bytes exponent{operand(exp_len)};
+    const Bytes modulus{operand(mod_len)};
+
+    // Leading zeros don't change the operands but make mod_exp slower, strip them.
+    // A zero modulus yields zero.
+    const ByteView base_view{without_leading_zeros(base)};
+    const ByteView exp_view{without_leading_zeros(exponent)};
+    const ByteView mod_view{without_leading_zeros(modulus)};
+
+    Bytes out(mod_len, '\0');
+    if (mod_view.empty()) {
+        return out;
+    }
+
+    // The result is smaller than the modulus, so it fits in its significant bytes
+    if (eosio::internal_use_do_not_use::mod_exp(as_chars(base_view.data()), base_view.size(),
+                                                as_chars(exp_view.data()), exp_view.size(),
+                                                as_chars(mod_view.data()), mod_view.size(),
+                                                as_chars(out.data() + (mod_len - mod_view.size())), mod_view.size()) != 0) {
+        return std::nullopt;
+    }
+    return out;
+}
+
+}  // namespace silkworm::precompile
@@ -0,0 +1,30 @@
+// SHA256 (0x02) and RIPEMD160 (0x03) precompiles of the contract build, computed by the sha256 and
+// ripemd160 host functions.
+
+#include <eosio/crypto.hpp>
+
+#include <silkworm/core/execution/precompile.hpp>
+
+#include "precompile_common.hpp"
+
+namespace silkworm::precompile {
+
+using namespace detail;
+
+uint64_t sha256_gas(ByteView input, evmc_revision) noexcept { return 60 + 12 * words(input); }
+
+std::optional<Bytes> sha256_run(ByteView input) noexcept {
+    const auto hash = eosio::sha256(as_chars(input.data()), input.size()).extract_as_byte_array();
+    return Bytes{hash.begin(), hash.end()};
+}
+
+uint64_t rip160_gas(ByteView input, evmc_revision) noexcept { return 600 + 120 * words(input); }
+
+std::optional<Bytes> rip160_run(ByteView input) noexcept {
+    const auto hash = eosio::ripemd160(as_chars(input.data()), input.size()).extract_as_byte_array();
+    Bytes out(12, '\0');
+    out.append(hash.begin(), hash.end());
+    return out;
+}
+
+}  // namespace silkworm::precompile
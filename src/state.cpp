@@ -26,7 +26,7 @@ std::optional<Account> state::read_account(const evmc::address& address) const n
         auto citr = codes.find(itr->code_id.value());
         if (citr != codes.end()) {
             code_hash = to_bytes32(citr->code_hash);
-            addr2code[code_hash] = citr->code;
+            addr2code.try_emplace(code_hash, citr->code.begin(), citr->code.end(), _arena);
         } else {
             // Should not reach here! 
             // Return empty hash for robustness.
@@ -41,8 +41,8 @@ std::optional<Account> state::read_account(const evmc::address& address) const n
 
 ByteView state::read_code(const evmc::bytes32& code_hash) const noexcept {
     
-    if(addr2code.find(code_hash) != addr2code.end()) {
-        const auto& code = addr2code[code_hash];
+    if(auto it = addr2code.find(code_hash); it != addr2code.end()) {
+        const auto& code = it->second;
         return ByteView{(const uint8_t*)code.data(), code.size()};
     }
     
@@ -54,8 +54,7 @@ ByteView state::read_code(const evmc::bytes32& code_hash) const noexcept {
         return ByteView{};
     }
 
-    addr2code[code_hash] = itr->code;
-    const auto& code = addr2code[code_hash];
+    const auto& code = addr2code.try_emplace(code_hash, itr->code.begin(), itr->code.end(), _arena).first->second;
     return ByteView{(const uint8_t*)code.data(), code.size()};
 }
 
@@ -6,6 +6,7 @@
 #include <evm_runtime/test/config.hpp>
 #include <evm_runtime/runtime_config.hpp>
 #include <evm_runtime/transaction.hpp>
+#include <ethash/keccak.hpp>
 namespace evm_runtime {
 using namespace silkworm;
 
@@ -367,6 +368,54 @@ using namespace silkworm;
             //should fail with overflow
         }
     }
+    if(test == "divpowten"_n) {
+        // udivrem_pow10 must match the generic division for every exponent a token precision can produce
+        const intx::uint256 values[] = {
+            0_u256, 1_u256, 9_u256, 10_u256, 999999999999999999_u256, 1000000000000000000_u256,
+            461168601842738790399999999999999_u256, 99999999461168601842738790399999999999999_u256,
+            0xffffffffffffffffffffffffffffffff_u256, 0x10000000000000000000000000000000000000000000000000_u256,
+            0xfedcba9876543210fedcba9876543210fedcba9876543210fedcba9876543210_u256,
+            std::numeric_limits<intx::uint256>::max(),
+        };
+        for (int exponent = 0; exponent <= 18; ++exponent) {
+            for (const auto& x : values) {
+                const auto expected = intx::udivrem(x, intx::uint256(pow10_const(exponent)));
+                const auto actual = udivrem_pow10(x, exponent);
+                check(actual.quot == expected.quot && actual.rem == expected.rem, "udivrem_pow10 mismatch");
+            }
+        }
+    }
+    if(test == "mulpercent"_n) {
+        // mul_hundred_percent must match the uint512 computation it replaces
+        const intx::uint256 values[] = {
+            0_u256, 1_u256, 99999_u256, 100000_u256, 21000000000000000_u256,
+            0xffffffffffffffffffffffffffffffff_u256,
+            0xfedcba9876543210fedcba9876543210fedcba9876543210fedcba9876543210_u256,
+            std::numeric_limits<intx::uint256>::max() - 1,
+        };
+        const uint32_t parts[] = {0, 1, 33333, 50000, 99999, hundred_percent};
+        for (const auto& x : values) {
+            for (uint32_t part : parts) {
+                const auto expected = static_cast<intx::uint256>(intx::uint512(x) * part / hundred_percent);
+                check(mul_hundred_percent(x, part) == expected, "mul_hundred_percent mismatch");
+            }
+        }
+    }
+    if(test == "basicnone"_n || test == "basicfull"_n) {
+        // precision 0: all 18 decimals are dust; precision 18: there is no dust at all
+        const uint8_t precision = test == "basicnone"_n ? 0 : 18;
+        balance_with_dust b{.balance=eosio::asset(0, eosio::symbol("EOS", precision)), .dust=0};
+        b += 1999999999999999999_u256;
+        b += 1_u256;
+        b -= 1000000000000000001_u256;
+        if(precision == 0) {
+            check(b.balance.amount == 0, "");
+            check(b.dust == 999999999999999999, "");
+        } else {
+            check(b.balance.amount == 999999999999999999, "");
+            check(b.dust == 0, "");
+        }
+    }
     if(test == "overflowd"_n) {
         balance_with_dust b{.balance=eosio::asset(0, eosio::symbol("EOS", 4u)), .dust=0};
         //add something massive
@@ -378,4 +427,13 @@ using namespace silkworm;
     }
 }
 
+// Hashes `data` with the keccak entry points linked into the contract (host sha3 for keccak-256, the portable
+// keccakf1600 sponge for keccak-512) so the tests can check them against the reference implementation.
+[[eosio::action]] std::vector<bytes> evm_contract::testkeccak(const bytes& data) {
+    const auto* ptr = reinterpret_cast<const uint8_t*>(data.data());
+    const auto h256 = ethash::keccak256(ptr, data.size());
+    const auto h512 = ethash::keccak512(ptr, data.size());
+    return {bytes{std::begin(h256.bytes), std::end(h256.bytes)}, bytes{std::begin(h512.bytes), std::end(h512.bytes)}};
+}
+
 }
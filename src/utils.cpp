@@ -1,5 +1,6 @@
 #include <eosio/eosio.hpp>
 #include <eosio/fixed_bytes.hpp>
+#include <iterator>
 #include <evm_runtime/types.hpp>
 
 namespace evm_runtime {
@@ -61,11 +62,120 @@ uint256 to_uint256(const bytes& value) {
     return intx::be::load<uint256>(tmp);
 }
 
+// 64x64->128 bit product from 32 bit halves, using only native i64.mul
+static inline void umul64(uint64_t x, uint64_t y, uint64_t& hi, uint64_t& lo) {
+    const uint64_t xl = uint32_t(x), xh = x >> 32;
+    const uint64_t yl = uint32_t(y), yh = y >> 32;
+    const uint64_t ll = xl * yl, lh = xl * yh, hl = xh * yl, hh = xh * yh;
+    const uint64_t mid = (ll >> 32) + uint32_t(lh) + uint32_t(hl);
+    lo = (mid << 32) | uint32_t(ll);
+    hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+}
+
+bool checked_mul(uint64_t a, const intx::uint256& b, intx::uint256& out) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        uint64_t hi, lo;
+        umul64(a, b[i], hi, lo);
+        lo += carry;
+        hi += lo < carry;
+        out[i] = lo;
+        carry = hi;
+    }
+    return carry == 0;
+}
+
+static constexpr uint64_t pow10_table[] = {
+    1ull, 10ull, 100ull, 1'000ull, 10'000ull, 100'000ull, 1'000'000ull, 10'000'000ull, 100'000'000ull,
+    1'000'000'000ull, 10'000'000'000ull, 100'000'000'000ull, 1'000'000'000'000ull, 10'000'000'000'000ull,
+    100'000'000'000'000ull, 1'000'000'000'000'000ull, 10'000'000'000'000'000ull,
+    100'000'000'000'000'000ull, 1'000'000'000'000'000'000ull, 10'000'000'000'000'000'000ull,
+};
+
 uint64_t pow10_const(int v) {
     eosio::check(v >= 0, "invalid exponent");
+    if (v < int(std::size(pow10_table))) return pow10_table[v];
     uint64_t r = 1;
     while (v-- > 0) r *= 10;
     return r;
 }
 
+// 10^k shifted left until its top bit is set, the shift, and the reciprocal
+// floor((2^128 - 1) / d) - 2^64 of the shifted divisor (Moller & Granlund, "Improved division by
+// invariant integers"). Entry k - 1 is for 10^k.
+struct pow10_reciprocal {
+    uint64_t d;
+    unsigned shift;
+    uint64_t v;
+};
+
+static constexpr pow10_reciprocal pow10_reciprocals[] = {
+    {0xa000000000000000, 60, 0x9999999999999999},  // 10^1
+    {0xc800000000000000, 57, 0x47ae147ae147ae14},  // 10^2
+    {0xfa00000000000000, 54, 0x0624dd2f1a9fbe76},  // 10^3
+    {0x9c40000000000000, 50, 0xa36e2eb1c432ca57},  // 10^4
+    {0xc350000000000000, 47, 0x4f8b588e368f0846},  // 10^5
+    {0xf424000000000000, 44, 0x0c6f7a0b5ed8d36b},  // 10^6
+    {0x9896800000000000, 40, 0xad7f29abcaf48578},  // 10^7
+    {0xbebc200000000000, 37, 0x5798ee2308c39df9},  // 10^8
+    {0xee6b280000000000, 34, 0x12e0be826d694b2e},  // 10^9
+    {0x9502f90000000000, 30, 0xb7cdfd9d7bdbab7d},  // 10^10
+    {0xba43b74000000000, 27, 0x5fd7fe17964955fd},  // 10^11
+    {0xe8d4a51000000000, 24, 0x19799812dea11197},  // 10^12
+    {0x9184e72a00000000, 20, 0xc25c268497681c26},  // 10^13
+    {0xb5e620f480000000, 17, 0x6849b86a12b9b01e},  // 10^14
+    {0xe35fa931a0000000, 14, 0x203af9ee756159b2},  // 10^15
+    {0x8e1bc9bf04000000, 10, 0xcd2b297d889bc2b6},  // 10^16
+    {0xb1a2bc2ec5000000,  7, 0x70ef54646d496892},  // 10^17
+    {0xde0b6b3a76400000,  4, 0x2725dd1d243aba0e},  // 10^18
+};
+
+// Divides the two word number (u1, u0) by the normalized d, with u1 < d
+static inline uint64_t udivrem_2by1(uint64_t u1, uint64_t u0, uint64_t d, uint64_t v, uint64_t& rem) {
+    uint64_t q1, q0;
+    umul64(v, u1, q1, q0);
+    q0 += u0;
+    q1 += u1 + 1 + (q0 < u0);
+    uint64_t r = u0 - q1 * d;
+    if (r > q0) {
+        --q1;
+        r += d;
+    }
+    if (r >= d) {
+        ++q1;
+        r -= d;
+    }
+    rem = r;
+    return q1;
+}
+
+intx::div_result<intx::uint256> udivrem_pow10(const intx::uint256& x, int exponent) {
+    if (exponent == 0) return {x, 0};
+    if (exponent < 0 || exponent > int(std::size(pow10_reciprocals))) {
+        return intx::udivrem(x, intx::uint256(pow10_const(exponent)));
+    }
+
+    // 10^k < 2^60 for every k in the table, so shift is never 0
+    const auto& r = pow10_reciprocals[exponent - 1];
+    uint64_t u[5];
+    u[4] = x[3] >> (64 - r.shift);
+    for (size_t i = 3; i > 0; --i) u[i] = (x[i] << r.shift) | (x[i - 1] >> (64 - r.shift));
+    u[0] = x[0] << r.shift;
+
+    intx::uint256 q;
+    uint64_t rem = u[4];
+    for (size_t i = 4; i-- > 0;) q[i] = udivrem_2by1(rem, u[i], r.d, r.v, rem);
+    return {q, rem >> r.shift};
+}
+
+intx::uint256 mul_hundred_percent(const intx::uint256& x, uint32_t part) {
+    static_assert(hundred_percent == 100'000);
+    eosio::check(part <= hundred_percent, "invalid percentage");
+    // x = q * 10^5 + r, so x * part / 10^5 = q * part + r * part / 10^5 with r * part < 10^10
+    const auto [q, r] = udivrem_pow10(x, 5);
+    intx::uint256 out;
+    checked_mul(part, q, out);
+    return out + intx::uint256(static_cast<uint64_t>(r) * part / hundred_percent);
+}
+
 }  // namespace silkworm
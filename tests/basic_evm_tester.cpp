@@ -444,7 +444,7 @@ transaction_trace_ptr basic_evm_tester::assertnonce(name account, uint64_t next_
       mvo()("account", account)("next_nonce", next_nonce));
 }
 
-transaction_trace_ptr basic_evm_tester::pushtx(const silkworm::Transaction& trx, name miner, std::optional<uint64_t> min_inclusion_price)
+transaction_trace_ptr basic_evm_tester::pushtx(const silkworm::Transaction& trx, name miner, std::optional<uint64_t> min_inclusion_price, std::optional<uint32_t> max_cpu_us)
 {
    silkworm::Bytes rlp;
    silkworm::rlp::encode(rlp, trx, false);
@@ -453,18 +453,52 @@ transaction_trace_ptr basic_evm_tester::pushtx(const silkworm::Transaction& trx,
    rlp_bytes.resize(rlp.size());
    memcpy(rlp_bytes.data(), rlp.data(), rlp.size());
 
-   if (min_inclusion_price.has_value()) {
+   if (max_cpu_us.has_value()) {
+      return push_action(evm_account_name, "pushtx"_n, miner, mvo()("miner", miner)("rlptx", rlp_bytes)("min_inclusion_price", min_inclusion_price.value_or(0))("max_cpu_us", max_cpu_us));
+   } else if (min_inclusion_price.has_value()) {
       return push_action(evm_account_name, "pushtx"_n, miner, mvo()("miner", miner)("rlptx", rlp_bytes)("min_inclusion_price", min_inclusion_price));
    } else {
       return push_action(evm_account_name, "pushtx"_n, miner, mvo()("miner", miner)("rlptx", rlp_bytes));
    }
 }
 
+transaction_trace_ptr basic_evm_tester::stagechunk(name miner, const bytes& chunk) {
+   return push_action(evm_account_name, "stagechunk"_n, miner, mvo()("miner", miner)("chunk", chunk));
+}
+
+transaction_trace_ptr basic_evm_tester::stagecommit(name miner) {
+   return push_action(evm_account_name, "stagecommit"_n, miner, mvo()("miner", miner));
+}
+
+transaction_trace_ptr basic_evm_tester::pushstaged(name miner, const bytes& hash, std::optional<uint64_t> min_inclusion_price, std::optional<uint32_t> max_cpu_us) {
+   if (max_cpu_us.has_value()) {
+      return push_action(evm_account_name, "pushstaged"_n, miner, mvo()("miner", miner)("hash", hash)("min_inclusion_price", min_inclusion_price.value_or(0))("max_cpu_us", max_cpu_us));
+   } else if (min_inclusion_price.has_value()) {
+      return push_action(evm_account_name, "pushstaged"_n, miner, mvo()("miner", miner)("hash", hash)("min_inclusion_price", min_inclusion_price));
+   } else {
+      return push_action(evm_account_name, "pushstaged"_n, miner, mvo()("miner", miner)("hash", hash));
+   }
+}
+
+transaction_trace_ptr basic_evm_tester::stagereset(name miner) {
+   return push_action(evm_account_name, "stagereset"_n, miner, mvo()("miner", miner));
+}
+
 transaction_trace_ptr basic_evm_tester::setversion(uint64_t version, name actor) {
    return basic_evm_tester::push_action(evm_account_name, "setversion"_n, actor,
       mvo()("version", version));
 }
 
+transaction_trace_ptr basic_evm_tester::compactevmtx(bool value, name actor) {
+   return basic_evm_tester::push_action(evm_account_name, "compactevmtx"_n, actor,
+      mvo()("value", value));
+}
+
+transaction_trace_ptr basic_evm_tester::fastdeposit(bool value, name actor) {
+   return basic_evm_tester::push_action(evm_account_name, "fastdeposit"_n, actor,
+      mvo()("value", value));
+}
+
 transaction_trace_ptr basic_evm_tester::updtgasparam(asset ram_price_mb, uint64_t gas_price, name actor) {
    return basic_evm_tester::push_action(evm_account_name, "updtgasparam"_n, actor,
       mvo()("ram_price_mb", ram_price_mb)("gas_price", gas_price));
@@ -68,8 +68,23 @@ struct evmtx_v3 : evmtx_base {
    uint64_t storage_price;
 };
 
+struct evmtx_compact {
+   uint64_t eos_evm_version;
+   uint32_t tx_index;
+   uint64_t base_fee_per_gas;
+   uint64_t overhead_price;
+   uint64_t storage_price;
+};
+
+struct evmtx_deposit {
+   uint64_t eos_evm_version;
+   uint64_t nonce;
+   uint64_t gas_price;
+   bytes to;
+   bytes value;
+};
 
-using evmtx_type = std::variant<evmtx_v1, evmtx_v3>;
+using evmtx_type = std::variant<evmtx_v1, evmtx_v3, evmtx_compact, evmtx_deposit>;
 
 struct evm_version_type {
    struct pending {
@@ -252,6 +267,8 @@ FC_REFLECT(evm_test::account_code, (id)(ref_count)(code)(code_hash));
 FC_REFLECT(evm_test::evmtx_base, (eos_evm_version)(rlptx));
 FC_REFLECT_DERIVED(evm_test::evmtx_v1, (evm_test::evmtx_base), (base_fee_per_gas));
 FC_REFLECT_DERIVED(evm_test::evmtx_v3, (evm_test::evmtx_base), (overhead_price)(storage_price));
+FC_REFLECT(evm_test::evmtx_compact, (eos_evm_version)(tx_index)(base_fee_per_gas)(overhead_price)(storage_price));
+FC_REFLECT(evm_test::evmtx_deposit, (eos_evm_version)(nonce)(gas_price)(to)(value));
 
 FC_REFLECT(evm_test::consensus_parameter_type, (current)(pending));
 FC_REFLECT(evm_test::pending_consensus_parameter_data_type, (data)(pending_time));
@@ -468,8 +485,14 @@ public:
    transaction_trace_ptr bridgeunreg(name receiver);
    transaction_trace_ptr exec(const exec_input& input, const std::optional<exec_callback>& callback);
    transaction_trace_ptr assertnonce(name account, uint64_t next_nonce);
-   transaction_trace_ptr pushtx(const silkworm::Transaction& trx, name miner = evm_account_name, std::optional<uint64_t> min_inclusion_price={});
+   transaction_trace_ptr pushtx(const silkworm::Transaction& trx, name miner = evm_account_name, std::optional<uint64_t> min_inclusion_price={}, std::optional<uint32_t> max_cpu_us={});
+   transaction_trace_ptr stagechunk(name miner, const bytes& chunk);
+   transaction_trace_ptr stagecommit(name miner);
+   transaction_trace_ptr pushstaged(name miner, const bytes& hash, std::optional<uint64_t> min_inclusion_price={}, std::optional<uint32_t> max_cpu_us={});
+   transaction_trace_ptr stagereset(name miner);
    transaction_trace_ptr setversion(uint64_t version, name actor);
+   transaction_trace_ptr compactevmtx(bool value, name actor=evm_account_name);
+   transaction_trace_ptr fastdeposit(bool value, name actor=evm_account_name);
    transaction_trace_ptr call(name from, const evmc::bytes& to, const evmc::bytes& value, evmc::bytes& data, uint64_t gas_limit, name actor);
    transaction_trace_ptr admincall(const evmc::bytes& from, const evmc::bytes& to, const evmc::bytes& value, evmc::bytes& data, uint64_t gas_limit, name actor);
    evmc::address deploy_contract(evm_eoa& eoa, evmc::bytes bytecode);
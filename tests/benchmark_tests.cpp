@@ -0,0 +1,647 @@
+#include "basic_evm_tester.hpp"
+#include <ethash/keccak.hpp>
+#include <silkworm/core/common/util.hpp>
+
+using intx::operator""_u256;
+
+using namespace evm_test;
+using namespace evmc::literals;
+
+// These tests report the CPU time spent by the contract on hot paths. They only check correctness,
+// timings are printed (run with --log_level=message) so builds can be compared, e.g. with and
+// without -DWITH_HOST_CRYPTO=ON.
+struct benchmark_tester : basic_evm_tester {
+
+   static constexpr size_t iterations = 5;
+
+   benchmark_tester() {
+      create_accounts({"alice"_n});
+      transfer_token(faucet_account_name, "alice"_n, make_asset(10000'0000));
+      init();
+
+      transfer_token("alice"_n, evm_account_name, make_asset(1000000), evm1.address_0x());
+   }
+
+   // Runs `data` against `to` using exec and returns the output along with the
+   // lowest elapsed time of the exec action over a few runs.
+   std::pair<exec_output, fc::microseconds> measure_exec(const evmc::address& to, const silkworm::Bytes& data) {
+      exec_input input;
+      input.context = {};
+      input.to      = bytes{std::begin(to.bytes), std::end(to.bytes)};
+      input.data    = bytes{data.begin(), data.end()};
+
+      std::optional<exec_output> out;
+      fc::microseconds best = fc::microseconds::maximum();
+      for (size_t i = 0; i < iterations; ++i) {
+         auto trace = exec(input, {});
+         BOOST_REQUIRE(trace->action_traces.size() == 1);
+         best = std::min(best, trace->action_traces[0].elapsed);
+         out = fc::raw::unpack<exec_output>(trace->action_traces[0].return_value);
+         produce_block();
+      }
+      return {*out, best};
+   }
+
+   // Signs and pushes `tx`, returning the elapsed time of the pushtx action.
+   fc::microseconds measure_pushtx(silkworm::Transaction& tx, evm_eoa& eoa, std::optional<uint32_t> max_cpu_us = {}) {
+      eoa.sign(tx);
+      auto trace = max_cpu_us ? pushtx(tx, evm_account_name, 0, max_cpu_us) : pushtx(tx);
+      produce_block();
+      return trace->action_traces[0].elapsed;
+   }
+
+   static constexpr auto secp256k1n = 0xfffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141_u256;
+
+   static silkworm::Bytes ecrecover_input(const silkworm::Transaction& tx, const intx::uint256& s, bool odd_y_parity) {
+      silkworm::Bytes rlp;
+      tx.encode_for_signing(rlp);
+      auto hash = silkworm::keccak256(rlp);
+
+      silkworm::Bytes input(128, 0);
+      std::memcpy(input.data(), hash.bytes, 32);
+      input[63] = odd_y_parity ? 28 : 27;
+      intx::be::unsafe::store(input.data() + 64, tx.r);
+      intx::be::unsafe::store(input.data() + 96, s);
+      return input;
+   }
+
+   static silkworm::Bytes from_hex(const std::string& hex) { return evmc::from_hex(hex).value(); }
+
+   // alt_bn128 generators and points used by the pairing benchmarks
+   static constexpr const char* g1 =
+      "0000000000000000000000000000000000000000000000000000000000000001"
+      "0000000000000000000000000000000000000000000000000000000000000002";
+   static constexpr const char* g1_neg =
+      "0000000000000000000000000000000000000000000000000000000000000001"
+      "30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd45";
+   static constexpr const char* g1_double =
+      "030644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd3"
+      "15ed738c0e0a7c92e7845f96b2ae9c0a68a6a449e3538fc7ff3ebf7a5a18a2c4";
+   static constexpr const char* g2 =
+      "198e9393920d483a7260bfb731fb5d25f1aa493335a9e71297e485b7aef312c2"
+      "1800deef121f1e76426a00665e5c4479674322d4f75edadd46debd5cd992f6ed"
+      "090689d0585ff075ec9e99ad690c3395bc4b313370b38ef355acdadcd122975b"
+      "12c85ea5db8c6deb4aab71808dcb408fe3d1e7690c43d37b4ce6cc0166fa7daa";
+
+   static silkworm::Bytes expmod_input(const silkworm::Bytes& base, const silkworm::Bytes& exp, const silkworm::Bytes& mod) {
+      silkworm::Bytes input;
+      input += evmc::bytes32{base.size()};
+      input += evmc::bytes32{exp.size()};
+      input += evmc::bytes32{mod.size()};
+      return input + base + exp + mod;
+   }
+
+   // EIP-2565 gas of a MODEXP call
+   static uint64_t expmod_gas(size_t base_len, const silkworm::Bytes& exp, size_t mod_len) {
+      const size_t head_len = std::min<size_t>(exp.size(), 32);
+      uint64_t head_bits = 0;
+      for (size_t i = 0; i < head_len; ++i) {
+         if (exp[i] != 0) {
+            head_bits = (head_len - i - 1) * 8 + (32 - __builtin_clz(exp[i]));
+            break;
+         }
+      }
+      uint64_t adjusted = exp.size() > 32 ? 8 * (exp.size() - 32) : 0;
+      if (head_bits > 1) adjusted += head_bits - 1;
+      adjusted = std::max<uint64_t>(adjusted, 1);
+
+      const uint64_t words = (std::max(base_len, mod_len) + 7) / 8;
+      return std::max<uint64_t>(200, words * words * adjusted / 3);
+   }
+
+   // Deploys `runtime` with an init code that returns it as is
+   evmc::address deploy_runtime(const silkworm::Bytes& runtime) {
+      // PUSH2 len DUP1 PUSH1 12 PUSH1 0 CODECOPY PUSH1 0 RETURN
+      silkworm::Bytes code{0x61, uint8_t(runtime.size() >> 8), uint8_t(runtime.size())};
+      code += from_hex("80600c6000396000f3");
+      return deploy_contract(evm1, code + runtime);
+   }
+
+   // Runtime that runs CALLDATALOAD(0) iterations of `unroll` copies of `body`
+   static silkworm::Bytes loop_runtime(const silkworm::Bytes& body, size_t unroll = 16) {
+      silkworm::Bytes loop;
+      for (size_t i = 0; i < unroll; ++i) loop += body;
+
+      // n = CALLDATALOAD(0); loop: if n == 0 goto end; body...; n -= 1; goto loop; end: STOP
+      const size_t end = 10 + loop.size() + 7;
+      silkworm::Bytes runtime = from_hex("6000355b801561");
+      runtime += silkworm::Bytes{uint8_t(end >> 8), uint8_t(end), 0x57};
+      runtime += loop;
+      runtime += from_hex("600190036003565b00");
+      return runtime;
+   }
+
+   evm_eoa evm1;
+};
+
+BOOST_AUTO_TEST_SUITE(benchmark_tests)
+
+BOOST_FIXTURE_TEST_CASE(keccak256_per_byte, benchmark_tester) try {
+
+   // runtime: CALLDATACOPY(0, 0, CALLDATASIZE) MSTORE(0, KECCAK256(0, CALLDATASIZE)) RETURN(0, 32)
+   // 36 6000 6000 37 36 6000 20 6000 52 6020 6000 f3
+   auto contract = deploy_contract(evm1, evmc::from_hex("6012600c60003960126000f3"
+                                                        "3660006000373660002060005260206000f3").value());
+
+   silkworm::Bytes empty;
+   auto [base_out, base_elapsed] = measure_exec(contract, empty);
+   BOOST_REQUIRE(base_out.status == 0);
+
+   for (size_t size : {32, 1024, 16384}) {
+      silkworm::Bytes data(size, 0);
+      for (size_t i = 0; i < size; ++i) data[i] = static_cast<uint8_t>(i * 7 + 3);
+
+      auto [out, elapsed] = measure_exec(contract, data);
+      BOOST_REQUIRE(out.status == 0);
+      BOOST_REQUIRE(out.data.size() == 32);
+
+      auto expected = ethash::keccak256(data.data(), data.size());
+      BOOST_REQUIRE(std::memcmp(out.data.data(), expected.bytes, 32) == 0);
+
+      auto delta = std::max<int64_t>(elapsed.count() - base_elapsed.count(), 0);
+      BOOST_TEST_MESSAGE("keccak256 " << size << " bytes: " << elapsed.count() << "us (base "
+                         << base_elapsed.count() << "us, " << double(delta) * 1000 / size << "ns/byte)");
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(pushtx_fixed_overhead, benchmark_tester) try {
+
+   // Plain transfers to an existing account: the cost is dominated by decoding and sender recovery.
+   evm_eoa evm2;
+   transfer_token("alice"_n, evm_account_name, make_asset(1), evm2.address_0x());
+
+   fc::microseconds best = fc::microseconds::maximum();
+   for (size_t i = 0; i < iterations; ++i) {
+      auto tx = generate_tx(evm2.address, 1);
+      best = std::min(best, measure_pushtx(tx, evm1));
+   }
+   BOOST_REQUIRE(evm_balance(evm2) == intx::uint256(balance_and_dust{make_asset(1), 0}) + iterations);
+   BOOST_TEST_MESSAGE("pushtx transfer: " << best.count() << "us");
+
+   // A high-s signature recovers to the same key but is not valid for transactions.
+   auto tx = generate_tx(evm2.address, 1);
+   evm1.sign(tx);
+   tx.s = secp256k1n - tx.s;
+   tx.odd_y_parity = !tx.odd_y_parity;
+   BOOST_REQUIRE_THROW(pushtx(tx), eosio_assert_message_exception);
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(ecrecover_precompile, benchmark_tester) try {
+
+   const auto ecrecover = 0x0000000000000000000000000000000000000001_address;
+
+   auto tx = generate_tx(evm1.address, 1);
+   evm1.sign(tx);
+
+   silkworm::Bytes expected(12, 0);
+   expected += silkworm::ByteView{evm1.address.bytes, sizeof(evm1.address.bytes)};
+
+   auto [out, elapsed] = measure_exec(ecrecover, ecrecover_input(tx, tx.s, tx.odd_y_parity));
+   BOOST_REQUIRE(out.status == 0);
+   BOOST_REQUIRE(silkworm::Bytes(out.data.begin(), out.data.end()) == expected);
+   BOOST_TEST_MESSAGE("ecrecover: " << elapsed.count() << "us");
+
+   // Unlike transactions, the precompile accepts high-s signatures
+   std::tie(out, elapsed) = measure_exec(ecrecover, ecrecover_input(tx, secp256k1n - tx.s, !tx.odd_y_parity));
+   BOOST_REQUIRE(out.status == 0);
+   BOOST_REQUIRE(silkworm::Bytes(out.data.begin(), out.data.end()) == expected);
+
+   // Out of range s returns nothing
+   std::tie(out, elapsed) = measure_exec(ecrecover, ecrecover_input(tx, secp256k1n, tx.odd_y_parity));
+   BOOST_REQUIRE(out.status == 0);
+   BOOST_REQUIRE(out.data.empty());
+
+   // Wrong message recovers a different address
+   auto input = ecrecover_input(tx, tx.s, tx.odd_y_parity);
+   input[0] ^= 0xff;
+   std::tie(out, elapsed) = measure_exec(ecrecover, input);
+   BOOST_REQUIRE(out.status == 0);
+   BOOST_REQUIRE(silkworm::Bytes(out.data.begin(), out.data.end()) != expected);
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(alt_bn128_precompiles, benchmark_tester) try {
+
+   const auto bn_add  = 0x0000000000000000000000000000000000000006_address;
+   const auto bn_mul  = 0x0000000000000000000000000000000000000007_address;
+   const auto pairing = 0x0000000000000000000000000000000000000008_address;
+
+   auto [out, elapsed] = measure_exec(bn_add, from_hex(std::string(g1) + g1));
+   BOOST_REQUIRE(out.status == 0);
+   BOOST_REQUIRE(silkworm::Bytes(out.data.begin(), out.data.end()) == from_hex(g1_double));
+   BOOST_TEST_MESSAGE("ecAdd: " << elapsed.count() << "us");
+
+   std::tie(out, elapsed) = measure_exec(bn_mul, from_hex(std::string(g1) + std::string(63 * 2, '0') + "02"));
+   BOOST_REQUIRE(out.status == 0);
+   BOOST_REQUIRE(silkworm::Bytes(out.data.begin(), out.data.end()) == from_hex(g1_double));
+   BOOST_TEST_MESSAGE("ecMul: " << elapsed.count() << "us");
+
+   // (1, 3) is not on the curve, the call fails
+   std::tie(out, elapsed) = measure_exec(bn_add, from_hex(std::string(63 * 2, '0') + "01" + std::string(63 * 2, '0') + "03"));
+   BOOST_REQUIRE(out.status != 0);
+
+   // e(P, Q) * e(-P, Q) == 1
+   const auto one = from_hex(std::string(63 * 2, '0') + "01");
+   const auto zero = silkworm::Bytes(32, 0);
+   const auto pair = std::string(g1) + g2 + g1_neg + g2;
+   std::tie(out, elapsed) = measure_exec(pairing, from_hex(pair));
+   BOOST_REQUIRE(out.status == 0);
+   BOOST_REQUIRE(silkworm::Bytes(out.data.begin(), out.data.end()) == one);
+   BOOST_TEST_MESSAGE("ecPairing 2 pairs: " << elapsed.count() << "us");
+
+   std::tie(out, elapsed) = measure_exec(pairing, from_hex(std::string(g1) + g2));
+   BOOST_REQUIRE(out.status == 0);
+   BOOST_REQUIRE(silkworm::Bytes(out.data.begin(), out.data.end()) == zero);
+
+   std::tie(out, elapsed) = measure_exec(pairing, {});
+   BOOST_REQUIRE(out.status == 0);
+   BOOST_REQUIRE(silkworm::Bytes(out.data.begin(), out.data.end()) == one);
+
+   // Input length must be a multiple of 192
+   std::tie(out, elapsed) = measure_exec(pairing, from_hex(std::string(g1)));
+   BOOST_REQUIRE(out.status != 0);
+
+   // A Groth16 verification is a 4 pairings check, it must fit in a single transaction
+   auto tx = generate_tx(pairing, 0, 300'000);
+   tx.data = from_hex(pair + pair);
+   std::tie(out, elapsed) = measure_exec(pairing, tx.data);
+   BOOST_REQUIRE(silkworm::Bytes(out.data.begin(), out.data.end()) == one);
+   BOOST_TEST_MESSAGE("ecPairing 4 pairs (groth16): " << elapsed.count() << "us exec, "
+                      << measure_pushtx(tx, evm1).count() << "us pushtx");
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(modexp_precompile, benchmark_tester) try {
+
+   const auto modexp = 0x0000000000000000000000000000000000000005_address;
+
+   // With base = m - 1 the result is m - 1 for odd exponents and 1 for even ones,
+   // which lets every case check its output without a reference implementation.
+   auto run = [&](const char* name, const silkworm::Bytes& mod, const silkworm::Bytes& exp, size_t base_padding = 0) {
+      silkworm::Bytes base(base_padding, 0);
+      base += mod;
+      base.back() -= 1;
+
+      auto [out, elapsed] = measure_exec(modexp, expmod_input(base, exp, mod));
+      BOOST_REQUIRE(out.status == 0);
+      BOOST_REQUIRE(out.data.size() == mod.size());
+
+      silkworm::Bytes expected(mod.size(), 0);
+      if (exp.back() & 1) {
+         expected = mod;
+         expected.back() -= 1;
+      } else {
+         expected.back() = 1;
+      }
+      BOOST_REQUIRE(silkworm::Bytes(out.data.begin(), out.data.end()) == expected);
+
+      const auto gas = expmod_gas(base.size(), exp, mod.size());
+      BOOST_TEST_MESSAGE("modexp " << name << ": " << elapsed.count() << "us, " << gas << " gas, "
+                         << double(elapsed.count()) * 1'000'000 / gas << "us/Mgas");
+   };
+
+   const silkworm::Bytes rsa2048(256, 0xff);
+   const silkworm::Bytes rsa4096(512, 0xff);
+   silkworm::Bytes even_mod(256, 0xff);
+   even_mod.back() = 0xfe;
+
+   run("rsa2048 verify (e=65537)", rsa2048, {0x01, 0x00, 0x01});
+   run("rsa2048 sign", rsa2048, silkworm::Bytes(256, 0xff));
+   run("rsa4096 sign", rsa4096, silkworm::Bytes(512, 0xff));
+   run("even modulus", even_mod, silkworm::Bytes(256, 0xff));
+   run("even exponent", rsa2048, silkworm::Bytes(256, 0xfe));
+
+   // Adversarial inputs: lots of gas spent on lengths that carry no work
+   run("1KB zero padded base", rsa2048, silkworm::Bytes(256, 0xff), 1024);
+   silkworm::Bytes padded_exp(1024, 0);
+   padded_exp.back() = 0x03;
+   run("1KB zero padded exponent", rsa2048, padded_exp);
+   run("small modulus, large exponent", silkworm::Bytes(1, 0xff), silkworm::Bytes(4096, 0xff));
+
+   // Zero modulus yields zero
+   auto [out, elapsed] = measure_exec(modexp, expmod_input({0x02}, {0x03}, silkworm::Bytes(32, 0)));
+   BOOST_REQUIRE(out.status == 0);
+   BOOST_REQUIRE(silkworm::Bytes(out.data.begin(), out.data.end()) == silkworm::Bytes(32, 0));
+
+   // Truncated input is right padded with zeros: the missing modulus is zero
+   auto input = expmod_input({0x02}, {0x03}, {0x07});
+   input.resize(input.size() - 1);
+   std::tie(out, elapsed) = measure_exec(modexp, input);
+   BOOST_REQUIRE(out.status == 0);
+   BOOST_REQUIRE(silkworm::Bytes(out.data.begin(), out.data.end()) == silkworm::Bytes{0x00});
+
+   // Zero modulus length returns nothing
+   std::tie(out, elapsed) = measure_exec(modexp, expmod_input({0x02}, {0x03}, {}));
+   BOOST_REQUIRE(out.status == 0);
+   BOOST_REQUIRE(out.data.empty());
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(blake2f_precompile, benchmark_tester) try {
+
+   const auto blake2f = 0x0000000000000000000000000000000000000009_address;
+
+   // EIP-152 test vectors: blake2b-512 of "abc" with different round counts and final flags
+   auto input = [](uint32_t rounds, uint8_t final) {
+      silkworm::Bytes in{uint8_t(rounds >> 24), uint8_t(rounds >> 16), uint8_t(rounds >> 8), uint8_t(rounds)};
+      in += evmc::from_hex(
+         "48c9bdf267e6096a3ba7ca8485ae67bb2bf894fe72f36e3cf1361d5f3af54fa5d182e6ad7f520e511f6c3e2b8c68059b6bbd41fbabd9831f79217e1319cde05b"
+         "6162630000000000000000000000000000000000000000000000000000000000"
+         "0000000000000000000000000000000000000000000000000000000000000000"
+         "0000000000000000000000000000000000000000000000000000000000000000"
+         "0000000000000000000000000000000000000000000000000000000000000000"
+         "03000000000000000000000000000000").value();
+      in.push_back(final);
+      return in;
+   };
+
+   auto check = [&](uint32_t rounds, uint8_t final, const char* expected) {
+      auto [out, elapsed] = measure_exec(blake2f, input(rounds, final));
+      BOOST_REQUIRE(out.status == 0);
+      BOOST_REQUIRE(silkworm::Bytes(out.data.begin(), out.data.end()) == from_hex(expected));
+   };
+
+   check(0, 1, "08c9bcf367e6096a3ba7ca8485ae67bb2bf894fe72f36e3cf1361d5f3af54fa5d282e6ad7f520e511f6c3e2b8c68059b9442be0454267ce079217e1319cde05b");
+   check(1, 1, "b63a380cb2897d521994a85234ee2c181b5f844d2c624c002677e9703449d2fba551b3a8333bcdf5f2f7e08993d53923de3d64fcc68c034e717b9293fed7a421");
+   check(12, 1, "ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2d17d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd4009923");
+   check(12, 0, "75ab69d3190a562c51aef8d88f1c2775876944407270c42c9844252c26d2875298743e7f6d5ea2f2d3e8d226039cd31b4e426ac4f2d3d666a610c2116fde4735");
+   check(1000, 1, "f92ac5126772237de3d2353169fe7697d4af3af4382778b05c7bb12e48903fbecefe56df2b901796d385e58cf759690a1bbec1aa9d95b5fa3ee79a575f116915");
+
+   // The final flag must be exactly 0 or 1
+   auto [out, elapsed] = measure_exec(blake2f, input(12, 2));
+   BOOST_REQUIRE(out.status != 0);
+
+   // Input must be exactly 213 bytes
+   auto longer = input(12, 1);
+   longer.push_back(0);
+   std::tie(out, elapsed) = measure_exec(blake2f, longer);
+   BOOST_REQUIRE(out.status != 0);
+   std::tie(out, elapsed) = measure_exec(blake2f, silkworm::Bytes(input(12, 1), 0, 212));
+   BOOST_REQUIRE(out.status != 0);
+
+   // Gas is one per round, so CPU per round is what matters
+   for (uint32_t rounds : {12u, 1'000u, 100'000u, 1'000'000u}) {
+      std::tie(out, elapsed) = measure_exec(blake2f, input(rounds, 1));
+      BOOST_REQUIRE(out.status == 0);
+      BOOST_TEST_MESSAGE("blake2f " << rounds << " rounds: " << elapsed.count() << "us, "
+                         << double(elapsed.count()) * 1000 / rounds << "ns/round");
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(sha256_ripemd160_precompiles, benchmark_tester) try {
+
+   const auto sha256    = 0x0000000000000000000000000000000000000002_address;
+   const auto ripemd160 = 0x0000000000000000000000000000000000000003_address;
+
+   for (size_t size : {0, 32, 1024, 16384}) {
+      silkworm::Bytes data(size, 0);
+      for (size_t i = 0; i < size; ++i) data[i] = static_cast<uint8_t>(i * 7 + 3);
+
+      auto [out, sha256_elapsed] = measure_exec(sha256, data);
+      BOOST_REQUIRE(out.status == 0);
+      auto sha256_expected = fc::sha256::hash(reinterpret_cast<const char*>(data.data()), data.size());
+      BOOST_REQUIRE(out.data.size() == 32);
+      BOOST_REQUIRE(std::memcmp(out.data.data(), sha256_expected.data(), 32) == 0);
+
+      // ripemd160 output is left padded to 32 bytes
+      auto [out2, ripemd160_elapsed] = measure_exec(ripemd160, data);
+      BOOST_REQUIRE(out2.status == 0);
+      auto ripemd160_expected = fc::ripemd160::hash(reinterpret_cast<const char*>(data.data()), data.size());
+      BOOST_REQUIRE(out2.data.size() == 32);
+      BOOST_REQUIRE(std::all_of(out2.data.begin(), out2.data.begin() + 12, [](char c) { return c == 0; }));
+      BOOST_REQUIRE(std::memcmp(out2.data.data() + 12, ripemd160_expected.data(), 20) == 0);
+
+      BOOST_TEST_MESSAGE("sha256 " << size << " bytes: " << sha256_elapsed.count() << "us, ripemd160 "
+                         << size << " bytes: " << ripemd160_elapsed.count() << "us");
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(nested_calls, benchmark_tester) try {
+
+   // runtime: d = CALLDATALOAD(0); if d == 0 RETURN(0, 32)
+   //          MSTORE(0, d - 1); MSTORE(0x2000, 0); CALL(GAS, ADDRESS, 0, 0, 32, 0, 32)
+   //          MSTORE(0, MLOAD(0) + 1); RETURN(0, 32)
+   // Every frame touches 8KiB of memory and returns the depth of the call tree below it.
+   auto contract = deploy_contract(evm1, evmc::from_hex("6036600c60003960366000f3"
+                                                        "60003580600c5760206000f35b600190036000526000612000526020"
+                                                        "6000602060006000305af15060005160010160005260206000f3").value());
+
+   // The production stack size only allows a handful of nested calls (see stack_limit_tests)
+   for (uint64_t depth : {1, 4, 8}) {
+      auto [out, elapsed] = measure_exec(contract, silkworm::Bytes(evmc::bytes32{depth}));
+      BOOST_REQUIRE(out.status == 0);
+      BOOST_REQUIRE(out.data.size() == 32);
+      BOOST_REQUIRE(intx::be::unsafe::load<intx::uint256>(reinterpret_cast<const uint8_t*>(out.data.data())) == depth);
+
+      BOOST_TEST_MESSAGE("nested calls depth " << depth << ": " << elapsed.count() << "us ("
+                         << elapsed.count() / depth << "us per frame)");
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(interpreter_cpu_per_gas, benchmark_tester) try {
+
+   // runtime: acc = 3; for (n = CALLDATALOAD(0); n != 0; --n) acc = MULMOD(acc, acc, p) + 7; return acc
+   // with p = 2^64 - 59. Each iteration costs 74 gas and is dominated by interpreter dispatch,
+   // which makes it a reference point for the CPU cost of a unit of gas.
+   // It is the baseline figure for evmone's advanced interpreter, which the contract does not build:
+   // its code analysis is redone on every action (WASM memory does not survive between actions) and
+   // costs more than baseline's jumpdest scan, so it only pays off on loops this long or longer.
+   auto contract = deploy_contract(evm1, evmc::from_hex("602f600c600039602f6000f3"
+                                                        "60036000355b80156025579067ffffffffffffffc581800990"
+                                                        "5060070190600190036005565b5060005260206000f3").value());
+
+   constexpr uint64_t gas_per_iteration = 74;
+   const intx::uint256 p = 0xffffffffffffffc5_u256;
+
+   for (uint64_t n : {1000, 5000}) {
+      auto [out, elapsed] = measure_exec(contract, silkworm::Bytes(evmc::bytes32{n}));
+      BOOST_REQUIRE(out.status == 0);
+      BOOST_REQUIRE(out.data.size() == 32);
+
+      intx::uint256 acc = 3;
+      for (uint64_t i = 0; i < n; ++i) acc = acc * acc % p + 7;
+      BOOST_REQUIRE(intx::be::unsafe::load<intx::uint256>(reinterpret_cast<const uint8_t*>(out.data.data())) == acc);
+
+      const uint64_t gas = n * gas_per_iteration;
+      BOOST_TEST_MESSAGE("mulmod loop " << n << " iterations, " << gas << " gas: " << elapsed.count() << "us ("
+                         << elapsed.count() * 1000 / gas << "ns per gas)");
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(arithmetic_opcodes, benchmark_tester) try {
+
+   // Operands wide enough to take the multi-word paths of intx
+   const std::string a = "7f" "fedcba9876543210fedcba9876543210fedcba9876543210fedcba9876543210";
+   const std::string b = "7f" "00000000000000000000000000000000123456789abcdef0123456789abcdef0";
+   const std::string m = "7f" "8000000000000000000000000000000000000000000000000000000000000033";
+
+   constexpr size_t unroll = 16;
+   constexpr uint64_t iterations = 100;
+
+   auto run = [&](const std::string& body) {
+      auto contract = deploy_runtime(loop_runtime(from_hex(body), unroll));
+      auto [out, elapsed] = measure_exec(contract, silkworm::Bytes(evmc::bytes32{iterations}));
+      BOOST_REQUIRE(out.status == 0);
+      return elapsed;
+   };
+
+   // Same stack traffic as the binary and ternary operations, without the operation
+   const auto base2 = run(b + a + "5050");
+   const auto base3 = run(m + b + a + "505050");
+
+   const std::vector<std::tuple<std::string, std::string, fc::microseconds>> ops = {
+      {"ADD",    "01", base2},
+      {"MUL",    "02", base2},
+      {"DIV",    "04", base2},
+      {"MOD",    "06", base2},
+      {"ADDMOD", "08", base3},
+      {"MULMOD", "09", base3},
+      {"EXP",    "0a", base2},
+   };
+   for (const auto& [name, opcode, base] : ops) {
+      const auto elapsed = run((name == "ADDMOD" || name == "MULMOD" ? m : std::string{}) + b + a + opcode + "50");
+      const auto delta = std::max<int64_t>(elapsed.count() - base.count(), 0);
+      BOOST_TEST_MESSAGE(name << ": " << elapsed.count() << "us for " << iterations * unroll << " ops ("
+                         << delta * 1000 / (iterations * unroll) << "ns per op)");
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(log_opcodes, benchmark_tester) try {
+
+   // LOGn charges gas for the topics and the data but the contract never reads the logs back
+   // (logs_bloom is a no-op). The difference to the same stack traffic without the LOG is what
+   // keeping the payload in the state journal costs, i.e. the most a log-elided mode could save.
+   // Eliding them means replacing IntraBlockState::add_log, which shares its translation unit with
+   // all the account and storage journaling, so it is only worth it if this number is large.
+   const std::string topic = "7f" "ddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef";
+
+   constexpr size_t unroll = 16;
+   constexpr uint64_t iterations = 100;
+
+   auto run = [&](const std::string& body) {
+      auto contract = deploy_runtime(loop_runtime(from_hex(body), unroll));
+      auto [out, elapsed] = measure_exec(contract, silkworm::Bytes(evmc::bytes32{iterations}));
+      BOOST_REQUIRE(out.status == 0);
+      return elapsed;
+   };
+
+   const std::vector<std::tuple<std::string, size_t, size_t>> logs = {
+      {"a0", 0, 32},
+      {"a3", 3, 32},    // ERC20 Transfer(from, to, value)
+      {"a1", 1, 256},
+      {"a4", 4, 1024},
+   };
+   for (const auto& [opcode, topics, size] : logs) {
+      // topics..., PUSH2 size, PUSH1 0
+      std::string push;
+      for (size_t i = 0; i < topics; ++i) push += topic;
+      push += "61" + evmc::hex(silkworm::Bytes{uint8_t(size >> 8), uint8_t(size)}) + "6000";
+
+      std::string pops;
+      for (size_t i = 0; i < topics + 2; ++i) pops += "50";
+
+      const auto base = run(push + pops);
+      const auto elapsed = run(push + opcode);
+      const auto delta = std::max<int64_t>(elapsed.count() - base.count(), 0);
+      const uint64_t gas = 375 + 375 * topics + 8 * size;
+      BOOST_TEST_MESSAGE("LOG" << topics << " " << size << " bytes, " << gas << " gas: " << elapsed.count() << "us for "
+                         << iterations * unroll << " logs (" << delta * 1000 / (iterations * unroll) << "ns per log)");
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(cpu_cost_calibration, benchmark_tester) try {
+
+   // Measures the parameters of cpu_cost_model on this machine and prints them in setcpumodel form.
+   // Each figure is the difference between two runs that only differ in the piece being measured.
+   evm_eoa evm2;
+   transfer_token("alice"_n, evm_account_name, make_asset(1), evm2.address_0x());
+
+   auto best_pushtx = [&](const evmc::address& to, const silkworm::Bytes& data, uint64_t gas_limit) {
+      fc::microseconds best = fc::microseconds::maximum();
+      for (size_t i = 0; i < iterations; ++i) {
+         auto tx = generate_tx(to, 1, gas_limit);
+         tx.data = data;
+         best = std::min(best, measure_pushtx(tx, evm1));
+      }
+      return best;
+   };
+   auto delta_ns = [](fc::microseconds a, fc::microseconds b, uint64_t n) {
+      return uint64_t(std::max<int64_t>(a.count() - b.count(), 0)) * 1000 / n;
+   };
+
+   // per_transaction: a plain transfer; per_tx_byte: the same with 16KiB of calldata
+   constexpr size_t data_size = 16 * 1024;
+   const auto transfer = best_pushtx(evm2.address, {}, 21000);
+   const auto transfer_data = best_pushtx(evm2.address, silkworm::Bytes(data_size, 1), 21000 + 16 * data_size);
+   const uint64_t per_transaction = uint64_t(transfer.count()) * 1000;
+   const uint64_t per_tx_byte = delta_ns(transfer_data, transfer, data_size);
+
+   // per_instruction: extra iterations of the 20 instruction mulmod loop of interpreter_cpu_per_gas
+   auto loop = deploy_contract(evm1, evmc::from_hex("602f600c600039602f6000f3"
+                                                    "60036000355b80156025579067ffffffffffffffc581800990"
+                                                    "5060070190600190036005565b5060005260206000f3").value());
+   constexpr uint64_t instructions_per_iteration = 20;
+   const auto loop_short = measure_exec(loop, silkworm::Bytes(evmc::bytes32{1000})).second;
+   const auto loop_long = measure_exec(loop, silkworm::Bytes(evmc::bytes32{5000})).second;
+   const uint64_t per_instruction = delta_ns(loop_long, loop_short, 4000 * instructions_per_iteration);
+
+   // per_frame: extra levels of the nested_calls contract, net of the 32 instructions each level runs
+   auto nested = deploy_contract(evm1, evmc::from_hex("6036600c60003960366000f3"
+                                                      "60003580600c5760206000f35b600190036000526000612000526020"
+                                                      "6000602060006000305af15060005160010160005260206000f3").value());
+   const auto depth1 = measure_exec(nested, silkworm::Bytes(evmc::bytes32{1})).second;
+   const auto depth8 = measure_exec(nested, silkworm::Bytes(evmc::bytes32{8})).second;
+   const uint64_t frame_and_body = delta_ns(depth8, depth1, 7);
+   const uint64_t per_frame = frame_and_body > 32 * per_instruction ? frame_and_body - 32 * per_instruction : 0;
+
+   // per_code_byte: the same STOP contract with 16KiB of unreachable code appended
+   silkworm::Bytes padded{0x00};
+   padded.resize(data_size + 1, 0x5b);
+   const auto stop_small = measure_exec(deploy_runtime(silkworm::Bytes{0x00}), {}).second;
+   const auto stop_large = measure_exec(deploy_runtime(padded), {}).second;
+   const uint64_t per_code_byte = delta_ns(stop_large, stop_small, data_size);
+
+   BOOST_TEST_MESSAGE("cpu cost model: per_transaction=" << per_transaction << " per_tx_byte=" << per_tx_byte
+                      << " per_instruction=" << per_instruction << " per_frame=" << per_frame
+                      << " per_code_byte=" << per_code_byte
+                      << " (per_log: see log_opcodes)");
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(cpu_budget_overhead, benchmark_tester) try {
+
+   // The same loop pushed without and with max_cpu_us. The budget is large enough to never trigger,
+   // so the difference is the cost of running cpu_budget_tracer on every instruction.
+   auto loop = deploy_contract(evm1, evmc::from_hex("602f600c600039602f6000f3"
+                                                    "60036000355b80156025579067ffffffffffffffc581800990"
+                                                    "5060070190600190036005565b5060005260206000f3").value());
+   constexpr uint64_t n = 5000;
+   constexpr uint64_t instructions = n * 20;
+
+   auto best = [&](std::optional<uint32_t> max_cpu_us) {
+      fc::microseconds best = fc::microseconds::maximum();
+      for (size_t i = 0; i < iterations; ++i) {
+         auto tx = generate_tx(loop, 0, 1'000'000);
+         tx.data = silkworm::Bytes(evmc::bytes32{n});
+         best = std::min(best, measure_pushtx(tx, evm1, max_cpu_us));
+      }
+      return best;
+   };
+
+   const auto untraced = best({});
+   const auto traced = best(1'000'000'000);
+   const auto delta = std::max<int64_t>(traced.count() - untraced.count(), 0);
+   BOOST_TEST_MESSAGE("cpu budget guard: " << untraced.count() << "us without, " << traced.count() << "us with ("
+                      << delta * 1000 / instructions << "ns per instruction)");
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
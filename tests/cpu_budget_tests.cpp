@@ -0,0 +1,135 @@
+#include "basic_evm_tester.hpp"
+
+using namespace evm_test;
+using eosio::testing::eosio_assert_message_is;
+
+struct cpu_budget_evm_tester : basic_evm_tester {
+   cpu_budget_evm_tester() {
+      create_accounts({"alice"_n});
+      transfer_token(faucet_account_name, "alice"_n, make_asset(10000'0000));
+      init();
+
+      setversion(1, evm_account_name);
+      produce_blocks(2);
+
+      transfer_token("alice"_n, evm_account_name, make_asset(100'0000), evm1.address_0x());
+   }
+
+   silkworm::Transaction make_tx(const evmc::address& to, silkworm::Bytes data, uint64_t gas_limit) {
+      const auto gas_price = get_config().gas_price;
+      silkworm::Transaction tx{
+         silkworm::UnsignedTransaction {
+            .type = silkworm::TransactionType::kLegacy,
+            .max_priority_fee_per_gas = gas_price,
+            .max_fee_per_gas = gas_price,
+            .gas_limit = gas_limit,
+            .to = to,
+            .value = 1,
+            .data = std::move(data),
+         }
+      };
+      evm1.sign(tx);
+      return tx;
+   }
+
+   transaction_trace_ptr setcpumodel(uint64_t per_transaction, uint64_t per_instruction, uint64_t per_frame, name actor = evm_account_name,
+                                     uint64_t per_tx_byte = 0, uint64_t per_code_byte = 0) {
+      return push_action(evm_account_name, "setcpumodel"_n, actor, mvo()("model", mvo()
+         ("per_transaction", per_transaction)("per_tx_byte", per_tx_byte)("per_instruction", per_instruction)
+         ("per_frame", per_frame)("per_code_byte", per_code_byte)
+         ("per_db_read", 0)("per_db_write", 0)("per_create", 0)("per_log", 0)));
+   }
+
+   evm_eoa evm1;
+   evm_eoa evm2;
+};
+
+BOOST_AUTO_TEST_SUITE(cpu_budget_tests)
+
+BOOST_FIXTURE_TEST_CASE(budget_guard, cpu_budget_evm_tester) try {
+
+   // The fixed per transaction estimate alone is over one microsecond
+   auto tx = make_tx(evm2.address, {}, 21000);
+   BOOST_REQUIRE_EXCEPTION(pushtx(tx, evm_account_name, 0, 1),
+                           eosio_assert_message_exception, eosio_assert_message_is("cpu budget exceeded"));
+   --evm1.next_nonce;
+
+   pushtx(make_tx(evm2.address, {}, 21000), evm_account_name, 0, 1'000'000);
+   produce_block();
+
+   // runtime: acc = 3; for (n = CALLDATALOAD(0); n != 0; --n) acc = MULMOD(acc, acc, 2^64 - 59) + 7; return acc
+   auto contract = deploy_contract(evm1, evmc::from_hex("602f600c600039602f6000f3"
+                                                        "60036000355b80156025579067ffffffffffffffc581800990"
+                                                        "5060070190600190036005565b5060005260206000f3").value());
+   produce_block();
+
+   // A long loop is stopped by the guard well before the Antelope deadline
+   tx = make_tx(contract, silkworm::Bytes(evmc::bytes32{100'000}), 10'000'000);
+   BOOST_REQUIRE_EXCEPTION(pushtx(tx, evm_account_name, 0, 5'000),
+                           eosio_assert_message_exception, eosio_assert_message_is("cpu budget exceeded"));
+   --evm1.next_nonce;
+
+   // The same budget covers a short one
+   pushtx(make_tx(contract, silkworm::Bytes(evmc::bytes32{10}), 10'000'000), evm_account_name, 0, 5'000);
+   produce_block();
+
+   // Without a budget the guard is off
+   pushtx(make_tx(contract, silkworm::Bytes(evmc::bytes32{1'000}), 10'000'000));
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(cost_model, cpu_budget_evm_tester) try {
+
+   BOOST_REQUIRE_EXCEPTION(setcpumodel(0, 0, 0, "alice"_n),
+                           missing_auth_exception, eosio::testing::fc_exception_message_starts_with("missing authority"));
+
+   // runtime: d = CALLDATALOAD(0); if d == 0 RETURN(0, 32) else CALL(GAS, ADDRESS, 0, 0, 32, 0, 32) with d - 1
+   auto contract = deploy_contract(evm1, evmc::from_hex("6036600c60003960366000f3"
+                                                        "60003580600c5760206000f35b600190036000526000612000526020"
+                                                        "6000602060006000305af15060005160010160005260206000f3").value());
+   produce_block();
+
+   // Only frames are charged: 0.3ms each against a 1ms budget
+   setcpumodel(0, 0, 300'000);
+   produce_block();
+
+   // Three frames fit
+   pushtx(make_tx(contract, silkworm::Bytes(evmc::bytes32{2}), 10'000'000), evm_account_name, 0, 1'000);
+   produce_block();
+
+   // The fourth one is stopped when it starts
+   auto tx = make_tx(contract, silkworm::Bytes(evmc::bytes32{3}), 10'000'000);
+   BOOST_REQUIRE_EXCEPTION(pushtx(tx, evm_account_name, 0, 1'000),
+                           eosio_assert_message_exception, eosio_assert_message_is("cpu budget exceeded"));
+   --evm1.next_nonce;
+
+   // A per transaction estimate over the budget rejects the transaction before it runs
+   setcpumodel(2'000'000, 0, 0);
+   produce_block();
+   tx = make_tx(evm2.address, {}, 21000);
+   BOOST_REQUIRE_EXCEPTION(pushtx(tx, evm_account_name, 0, 1'000),
+                           eosio_assert_message_exception, eosio_assert_message_is("cpu budget exceeded"));
+   --evm1.next_nonce;
+
+   // So does its size: 10ns per byte against 5us lets a short transaction through but not 1KiB of calldata
+   setcpumodel(0, 0, 0, evm_account_name, 10, 0);
+   produce_block();
+   pushtx(make_tx(evm2.address, {}, 21000), evm_account_name, 0, 5);
+   produce_block();
+   tx = make_tx(evm2.address, silkworm::Bytes(1024, 1), 100'000);
+   BOOST_REQUIRE_EXCEPTION(pushtx(tx, evm_account_name, 0, 5),
+                           eosio_assert_message_exception, eosio_assert_message_is("cpu budget exceeded"));
+   --evm1.next_nonce;
+
+   // The code size of a frame is charged before its first instruction: 54 bytes at 100ns is over 5us
+   setcpumodel(0, 0, 0, evm_account_name, 0, 100);
+   produce_block();
+   pushtx(make_tx(evm2.address, {}, 21000), evm_account_name, 0, 5);
+   produce_block();
+   tx = make_tx(contract, silkworm::Bytes(evmc::bytes32{0}), 10'000'000);
+   BOOST_REQUIRE_EXCEPTION(pushtx(tx, evm_account_name, 0, 5),
+                           eosio_assert_message_exception, eosio_assert_message_is("cpu budget exceeded"));
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
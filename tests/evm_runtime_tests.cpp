@@ -28,6 +28,7 @@
 #include <silkworm/core/types/transaction.hpp>
 #include <silkworm/core/rlp/encode.hpp>
 #include <silkworm/core/rlp/decode_vector.hpp>
+#include <ethash/keccak.hpp>
 
 #include <silkworm/core/state/state.hpp>
 #include <silkworm/core/protocol/blockchain.hpp>
@@ -628,6 +629,15 @@ struct evm_runtime_tester : eosio_system_tester, silkworm::State {
       );
    }
 
+   std::vector<std::string> testkeccak( const bytes& data ) {
+      auto trace = base_tester::push_action(ME, "testkeccak"_n, ME, mvo()("data", data));
+      std::vector<std::string> res;
+      for(const auto& h : fc::raw::unpack<std::vector<bytes>>(trace->action_traces[0].return_value)) {
+         res.push_back(fc::to_hex(h.data(), h.size()));
+      }
+      return res;
+   }
+
    //------ silkworm state impl
    std::optional<Account> read_account(const evmc::address& address) const noexcept {
       auto& db = const_cast<chainbase::database&>(control->db());
@@ -1187,6 +1197,10 @@ BOOST_AUTO_TEST_CASE( balance_and_dust_tests ) try {
    evm_runtime_tester t(tmpdir);
 
    BOOST_REQUIRE_EQUAL(t.testbaldust("basic"_n),      t.success());
+   BOOST_REQUIRE_EQUAL(t.testbaldust("basicnone"_n),  t.success());
+   BOOST_REQUIRE_EQUAL(t.testbaldust("basicfull"_n),  t.success());
+   BOOST_REQUIRE_EQUAL(t.testbaldust("divpowten"_n),  t.success());
+   BOOST_REQUIRE_EQUAL(t.testbaldust("mulpercent"_n), t.success());
 
    BOOST_REQUIRE_EQUAL(t.testbaldust("underflow1"_n), t.error("assertion failure with message: decrementing more than available"));
    BOOST_REQUIRE_EQUAL(t.testbaldust("underflow2"_n), t.error("assertion failure with message: decrementing more than available"));
@@ -1205,4 +1219,32 @@ BOOST_AUTO_TEST_CASE( balance_and_dust_tests ) try {
    BOOST_REQUIRE_EQUAL(t.testbaldust("overflowd"_n),  t.error("assertion failure with message: accumulation overflow"));
 } FC_LOG_AND_RETHROW()
 
+BOOST_AUTO_TEST_CASE( keccak_known_answer_tests ) try {
+   fc::temp_directory tmpdir;
+   evm_runtime_tester t(tmpdir);
+
+   auto h = t.testkeccak({});
+   BOOST_REQUIRE_EQUAL(h[0], "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+   BOOST_REQUIRE_EQUAL(h[1], "0eab42de4c3ceb9235fc91acffe746b29c29a8c366b7c60e4e67c466f36a4304"
+                             "c00fa9caf9d87976ba469bcbe06713b435f091ef2769fb160cdab33d3670680e");
+
+   h = t.testkeccak({'a', 'b', 'c'});
+   BOOST_REQUIRE_EQUAL(h[0], "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45");
+   BOOST_REQUIRE_EQUAL(h[1], "18587dc2ea106b9a1563e32b3312421ca164c7f1f07bc922a9c83d77cea3a1e5"
+                             "d0c69910739025372dc14ac9642629379540c17e2a65b19d77aa511a9d00bb96");
+
+   // Around the keccak-512 (72) and keccak-256 (136) rates and a multi-block input, against the reference
+   // ethash implementation linked into the tester
+   for(size_t size : {71, 72, 73, 135, 136, 137, 1000}) {
+      bytes data(size);
+      for(size_t i = 0; i < size; ++i) data[i] = char(i * 7 + 1);
+
+      const auto h256 = ethash::keccak256(reinterpret_cast<const uint8_t*>(data.data()), size);
+      const auto h512 = ethash::keccak512(reinterpret_cast<const uint8_t*>(data.data()), size);
+      h = t.testkeccak(data);
+      BOOST_REQUIRE_EQUAL(h[0], fc::to_hex(reinterpret_cast<const char*>(h256.bytes), sizeof(h256.bytes)));
+      BOOST_REQUIRE_EQUAL(h[1], fc::to_hex(reinterpret_cast<const char*>(h512.bytes), sizeof(h512.bytes)));
+   }
+} FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,4 +1,5 @@
 #include "basic_evm_tester.hpp"
+#include <cinttypes>
 #include <silkworm/core/execution/address.hpp>
 
 using intx::operator""_u256;
@@ -248,4 +249,65 @@ BOOST_FIXTURE_TEST_CASE(wrong_input_params, exec_evm_tester) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(erc20_fusable_sequences, exec_evm_tester) try {
+
+  evm_eoa evm1;
+  const int64_t to_bridge = 1000000;
+  transfer_token("alice"_n, "evm"_n, make_asset(to_bridge), evm1.address_0x());
+
+  auto token_addr = deploy_evm_token_contract(evm1);
+
+  // A transfer run through exec executes the same code as pushtx without changing state
+  evm_eoa evm2;
+  exec_input input;
+  input.from = bytes{std::begin(evm1.address.bytes), std::end(evm1.address.bytes)};
+  input.to = bytes{std::begin(token_addr.bytes), std::end(token_addr.bytes)};
+  silkworm::Bytes data;
+  data += evmc::from_hex("a9059cbb").value();   // sha3(transfer(address,uint256))[:4]
+  data += silkworm::to_bytes32(evm2.address);
+  data += evmc::bytes32{1234};
+  input.data = bytes{data.begin(), data.end()};
+
+  auto balance_res = erc20_balance(token_addr, evm1);
+  auto balance_out = fc::raw::unpack<exec_output>(balance_res->action_traces[0].return_value);
+  BOOST_REQUIRE(balance_out.status == 0);
+  BOOST_REQUIRE(balance_out.data.size() == 32);
+  BOOST_REQUIRE(intx::be::unsafe::load<intx::uint256>(reinterpret_cast<const uint8_t*>(balance_out.data.data())) >= 1234);
+
+  auto transfer_res = exec(input, {});
+  auto transfer_out = fc::raw::unpack<exec_output>(transfer_res->action_traces[0].return_value);
+  BOOST_REQUIRE(transfer_out.status == 0);
+  BOOST_REQUIRE(transfer_out.data.size() == 32 && transfer_out.data[31] == 1);
+
+  // exec does not change state
+  BOOST_REQUIRE(erc20_balance(token_addr, evm1)->action_traces[0].return_value == balance_res->action_traces[0].return_value);
+
+  // Only builds with -DWITH_FUSION_STATS=ON print the counters
+#ifndef WITH_FUSION_STATS
+  BOOST_REQUIRE(balance_res->action_traces[0].console.find("FUSION:") == std::string::npos);
+  BOOST_TEST_MESSAGE("fusion counters skipped, configure the contract and the tests with -DWITH_FUSION_STATS=ON");
+#else
+  for (auto res : {balance_res, transfer_res}) {
+    const auto& console = res->action_traces[0].console;
+    const auto pos = console.find("FUSION:");
+    BOOST_REQUIRE(pos != std::string::npos);
+
+    uint64_t instructions = 0, push_jumpi = 0, push_jump = 0, push1_add = 0, selector = 0, saved = 0;
+    BOOST_REQUIRE(sscanf(console.c_str() + pos,
+                         "FUSION: instructions=%" SCNu64 " push_jumpi=%" SCNu64 " push_jump=%" SCNu64
+                         " push1_add=%" SCNu64 " selector=%" SCNu64 " saved=%" SCNu64,
+                         &instructions, &push_jumpi, &push_jump, &push1_add, &selector, &saved) == 6);
+    BOOST_REQUIRE(instructions > 0);
+    BOOST_REQUIRE(selector > 0);
+    BOOST_REQUIRE(saved == push_jumpi + push_jump + push1_add + 3 * selector);
+    BOOST_REQUIRE(saved < instructions);
+
+    BOOST_TEST_MESSAGE("erc20 " << instructions << " instructions, push_jumpi " << push_jumpi << ", push_jump "
+                       << push_jump << ", push1_add " << push1_add << ", selector " << selector << ": "
+                       << saved * 100 / instructions << "% of dispatches fusable");
+  }
+#endif
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -580,4 +580,92 @@ try {
 }
 FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(plain_transfer_fast_path, gas_fee_evm_tester)
+try {
+   // Transfers to a new account take the full execution path, transfers to an existing
+   // account without code take the fast path. Both must produce exactly the same changes.
+   init();
+
+   auto miner_account = "miner"_n;
+   create_accounts({miner_account});
+   open(miner_account);
+
+   evm_eoa evm1;
+   transfer_token("alice"_n, evm_account_name, make_asset(10'0000), evm1.address_0x());
+
+   struct snapshot {
+      intx::uint256 sender, receiver, miner, self, inevm;
+      uint64_t nonce;
+   };
+
+   auto take_snapshot = [&](const evm_eoa& to) {
+      auto sender = find_account_by_address(evm1.address);
+      BOOST_REQUIRE(sender.has_value());
+      return snapshot{
+         .sender   = sender->balance,
+         .receiver = evm_balance(to).value_or(0),
+         .miner    = intx::uint256(vault_balance(miner_account)),
+         .self     = intx::uint256(vault_balance(evm_account_name)),
+         .inevm    = intx::uint256(inevm()),
+         .nonce    = sender->nonce
+      };
+   };
+
+   auto transfer = [&](const evm_eoa& to, silkworm::Transaction tx) {
+      auto before = take_snapshot(to);
+      evm1.sign(tx);
+      pushtx(tx, miner_account);
+      auto after = take_snapshot(to);
+      return snapshot{
+         .sender   = before.sender - after.sender,
+         .receiver = after.receiver - before.receiver,
+         .miner    = after.miner - before.miner,
+         .self     = after.self - before.self,
+         .inevm    = after.inevm - before.inevm,
+         .nonce    = after.nonce - before.nonce
+      };
+   };
+
+   auto require_same = [](const snapshot& full, const snapshot& fast) {
+      BOOST_REQUIRE(full.sender == fast.sender);
+      BOOST_REQUIRE(full.receiver == fast.receiver);
+      BOOST_REQUIRE(full.miner == fast.miner);
+      BOOST_REQUIRE(full.self == fast.self);
+      BOOST_REQUIRE(full.inevm == fast.inevm);
+      BOOST_REQUIRE(full.nonce == 1 && fast.nonce == 1);
+   };
+
+   // Version 0
+   {
+      evm_eoa evm2;
+      auto full = transfer(evm2, generate_tx(evm2.address, 1'000'000));
+      auto fast = transfer(evm2, generate_tx(evm2.address, 1'000'000));
+      require_same(full, fast);
+      BOOST_REQUIRE(fast.receiver == 1'000'000);
+      BOOST_REQUIRE(fast.miner > 0);
+   }
+
+   setversion(1, evm_account_name);
+   produce_blocks(3);
+   transfer_token("alice"_n, evm_account_name, make_asset(1), evm1.address_0x());
+
+   // Version 1, with and without inclusion fee
+   for (uint64_t priority_fee : {uint64_t{0}, uint64_t{10'000'000'000}}) {
+      auto make_tx = [&](const evm_eoa& to) {
+         auto tx = generate_tx(to.address, 1'000'000);
+         tx.type = silkworm::TransactionType::kDynamicFee;
+         tx.max_priority_fee_per_gas = priority_fee;
+         tx.max_fee_per_gas = suggested_gas_price + priority_fee;
+         return tx;
+      };
+
+      evm_eoa evm2;
+      auto full = transfer(evm2, make_tx(evm2));
+      auto fast = transfer(evm2, make_tx(evm2));
+      require_same(full, fast);
+      BOOST_REQUIRE(fast.miner == intx::uint256(21'000) * priority_fee);
+   }
+}
+FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()
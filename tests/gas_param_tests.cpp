@@ -195,6 +195,37 @@ BOOST_FIXTURE_TEST_CASE(basic, gas_param_evm_tester) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(gas_per_byte_rounding, gas_param_evm_tester) try {
+
+    init();
+
+    setversion(1, evm_account_name);
+    produce_blocks(2);
+    fund_evm_faucet();
+
+    auto check_gas_per_byte = [&](const asset& ram_price_mb, uint64_t gas_price, uint64_t gas_per_byte) {
+        updtgasparam(ram_price_mb, gas_price, evm_account_name);
+        auto cfg = get_config();
+        BOOST_REQUIRE(cfg.consensus_parameter.has_value() && cfg.consensus_parameter->pending.has_value());
+        std::visit([&](auto& v){
+            BOOST_REQUIRE_EQUAL(v.gas_parameter.gas_txnewaccount, 347 * gas_per_byte);
+            BOOST_REQUIRE_EQUAL(v.gas_parameter.gas_newaccount, 347 * gas_per_byte);
+            BOOST_REQUIRE_EQUAL(v.gas_parameter.gas_txcreate, 606 * gas_per_byte);
+            BOOST_REQUIRE_EQUAL(v.gas_parameter.gas_codedeposit, gas_per_byte);
+            BOOST_REQUIRE_EQUAL(v.gas_parameter.gas_sset, 2900 + 346 * gas_per_byte);
+        }, cfg.consensus_parameter->pending->data);
+    };
+
+    // gas_per_byte = floor(ram_price_mb * 10^14 / 2^20 / gas_price) + 1
+    check_gas_per_byte(asset(10'0000, native_symbol), 1'000'000'000, 9537);
+    check_gas_per_byte(asset(50'0000, native_symbol), 150'000'000'000, 318);
+    check_gas_per_byte(asset(1, native_symbol), 1'000'000'000, 1);
+    check_gas_per_byte(asset(0, native_symbol), 1, 1);
+    // exact quotient: 2^20 * 10^-4 EOS per MB at 10^14 wei gas price
+    check_gas_per_byte(asset(1024 * 1024, native_symbol), 100'000'000'000'000, 2);
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE(gas_param_traces, gas_param_evm_tester) try {
 
     init();
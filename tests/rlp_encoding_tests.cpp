@@ -52,4 +52,35 @@ BOOST_FIXTURE_TEST_CASE(wrap_tx_in_string, rlp_encoding_tester) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(large_calldata_tx, rlp_encoding_tester) try {
+
+    // Fund evm1 address with 10.0000 EOS
+    evm_eoa evm1;
+    transfer_token("alice"_n, evm_account_name, make_asset(10'0000), evm1.address_0x());
+
+    evm_eoa evm2;
+
+    // 16KB of non-zero calldata sent to an EOA
+    auto tx = generate_tx(evm2.address, 1, 21'000 + 16 * 16'384);
+    tx.data = silkworm::Bytes(16'384, 0x5a);
+    evm1.sign(tx);
+
+    BOOST_CHECK_NO_THROW(my_pushtx(tx, false));
+    BOOST_REQUIRE(evm_balance(evm2) == 1);
+
+    // Trailing garbage after the transaction must still be rejected
+    silkworm::Bytes rlp;
+    silkworm::rlp::encode(rlp, tx, false);
+    rlp.push_back(0x00);
+
+    bytes rlp_bytes;
+    rlp_bytes.resize(rlp.size());
+    memcpy(rlp_bytes.data(), rlp.data(), rlp.size());
+
+    BOOST_REQUIRE_EXCEPTION(push_action(evm_account_name, "pushtx"_n, evm_account_name, mvo()("miner", evm_account_name)("rlptx", rlp_bytes)),
+        eosio_assert_message_exception,
+        [](const eosio_assert_message_exception& e) {return testing::expect_assert_message(e, "unable to decode transaction");});
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()
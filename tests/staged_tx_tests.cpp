@@ -0,0 +1,189 @@
+#include "basic_evm_tester.hpp"
+#include <ethash/keccak.hpp>
+#include <silkworm/core/execution/address.hpp>
+
+using namespace evm_test;
+using eosio::testing::eosio_assert_message_is;
+
+struct staged_tx_evm_tester : basic_evm_tester {
+   explicit staged_tx_evm_tester(uint64_t version = 1) {
+      create_accounts({"alice"_n});
+      transfer_token(faucet_account_name, "alice"_n, make_asset(10000'0000));
+      init();
+
+      if (version > 0) {
+         setversion(version, evm_account_name);
+         produce_blocks(2);
+      }
+
+      transfer_token("alice"_n, evm_account_name, make_asset(100'0000), evm1.address_0x());
+   }
+
+   // Signed deployment of a contract whose runtime returns 42, padded to `size` bytes of code
+   bytes signed_deployment(size_t size) {
+      // MSTORE(0, 42) RETURN(0, 32), followed by unreachable JUMPDESTs
+      silkworm::Bytes runtime = evmc::from_hex("602a60005260206000f3").value();
+      runtime.resize(size, 0x5b);
+
+      // PUSH2 len DUP1 PUSH1 12 PUSH1 0 CODECOPY PUSH1 0 RETURN
+      silkworm::Bytes code{0x61, uint8_t(runtime.size() >> 8), uint8_t(runtime.size())};
+      code += evmc::from_hex("80600c6000396000f3").value();
+
+      const auto gas_price = get_config().gas_price;
+      silkworm::Transaction tx{
+         silkworm::UnsignedTransaction {
+            .type = silkworm::TransactionType::kLegacy,
+            .max_priority_fee_per_gas = gas_price,
+            .max_fee_per_gas = gas_price,
+            .gas_limit = 10'000'000,
+            .data = code + runtime,
+         }
+      };
+      evm1.sign(tx);
+
+      silkworm::Bytes rlp;
+      silkworm::rlp::encode(rlp, tx, false);
+      return bytes{rlp.begin(), rlp.end()};
+   }
+
+   static bytes keccak(const bytes& data) {
+      const auto hash = ethash::keccak256(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+      return bytes{std::begin(hash.bytes), std::end(hash.bytes)};
+   }
+
+   void stage(const bytes& rlptx, size_t chunk_size) {
+      for (size_t pos = 0; pos < rlptx.size(); pos += chunk_size) {
+         const size_t n = std::min(chunk_size, rlptx.size() - pos);
+         stagechunk(evm_account_name, bytes{rlptx.begin() + pos, rlptx.begin() + pos + n});
+         produce_block();
+      }
+   }
+
+   exec_output call_contract(const evmc::address& contract) {
+      exec_input input;
+      input.context = {};
+      input.to = bytes{std::begin(contract.bytes), std::end(contract.bytes)};
+      auto trace = exec(input, {});
+      return fc::raw::unpack<exec_output>(trace->action_traces[0].return_value);
+   }
+
+   evm_eoa evm1;
+};
+
+struct staged_tx_v0_evm_tester : staged_tx_evm_tester {
+   staged_tx_v0_evm_tester() : staged_tx_evm_tester(0) {}
+};
+
+BOOST_AUTO_TEST_SUITE(staged_tx_tests)
+
+BOOST_FIXTURE_TEST_CASE(staged_deployment, staged_tx_evm_tester) try {
+
+   const auto contract = silkworm::create_address(evm1.address, 0);
+   const auto rlptx = signed_deployment(20'000);
+   const auto hash = keccak(rlptx);
+
+   stage(rlptx, 8 * 1024);
+
+   BOOST_REQUIRE_EXCEPTION(pushstaged(evm_account_name, hash),
+                           eosio_assert_message_exception, eosio_assert_message_is("staged transaction not committed"));
+
+   stagecommit(evm_account_name);
+
+   BOOST_REQUIRE_EXCEPTION(stagechunk(evm_account_name, bytes{1}),
+                           eosio_assert_message_exception, eosio_assert_message_is("staged transaction already committed"));
+   BOOST_REQUIRE_EXCEPTION(stagecommit(evm_account_name),
+                           eosio_assert_message_exception, eosio_assert_message_is("staged transaction already committed"));
+
+   auto wrong_hash = hash;
+   wrong_hash[0] ^= 1;
+   BOOST_REQUIRE_EXCEPTION(pushstaged(evm_account_name, wrong_hash),
+                           eosio_assert_message_exception, eosio_assert_message_is("staged transaction hash mismatch"));
+
+   // The rlptx is not in the action data, so the evmtx event carries it
+   auto trace = pushstaged(evm_account_name, hash);
+   BOOST_REQUIRE_EQUAL(trace->action_traces.size(), 2);
+   BOOST_REQUIRE(trace->action_traces[1].act.name == "evmtx"_n);
+   auto event = fc::raw::unpack<evmtx_type>(trace->action_traces[1].act.data);
+   BOOST_REQUIRE(std::holds_alternative<evmtx_v1>(event));
+   BOOST_REQUIRE(std::get<evmtx_v1>(event).rlptx == rlptx);
+
+   auto out = call_contract(contract);
+   BOOST_REQUIRE_EQUAL(out.status, 0);
+   BOOST_REQUIRE(out.data.size() == 32 && out.data[31] == 42);
+
+   // The staging area is released
+   produce_block();
+   BOOST_REQUIRE_EXCEPTION(pushstaged(evm_account_name, hash),
+                           eosio_assert_message_exception, eosio_assert_message_is("no staged transaction"));
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(staging_area, staged_tx_evm_tester) try {
+
+   // Only the miner can stage transactions in its own area
+   BOOST_REQUIRE_EXCEPTION(push_action(evm_account_name, "stagechunk"_n, evm_account_name, mvo()("miner", "alice"_n)("chunk", bytes{1})),
+                           missing_auth_exception, eosio::testing::fc_exception_message_starts_with("missing authority"));
+
+   BOOST_REQUIRE_EXCEPTION(stagecommit(evm_account_name),
+                           eosio_assert_message_exception, eosio_assert_message_is("no staged transaction"));
+
+   // Reset discards a partial upload and a new one can start over
+   const auto rlptx = signed_deployment(100);
+   stage(bytes{rlptx.begin(), rlptx.begin() + 10}, 8);
+   stagereset(evm_account_name);
+   BOOST_REQUIRE_EXCEPTION(stagecommit(evm_account_name),
+                           eosio_assert_message_exception, eosio_assert_message_is("no staged transaction"));
+
+   const auto contract = silkworm::create_address(evm1.address, 0);
+   stage(rlptx, 16);
+   stagecommit(evm_account_name);
+   pushstaged(evm_account_name, keccak(rlptx));
+   BOOST_REQUIRE_EQUAL(call_contract(contract).status, 0);
+
+   // pushstaged takes the miner options of pushtx
+   produce_block();
+   const auto rlptx2 = signed_deployment(100);
+   stage(rlptx2, 64);
+   stagecommit(evm_account_name);
+   BOOST_REQUIRE_EXCEPTION(pushstaged(evm_account_name, keccak(rlptx2), 0, 1),
+                           eosio_assert_message_exception, eosio_assert_message_is("cpu budget exceeded"));
+   BOOST_REQUIRE_EXCEPTION(pushstaged(evm_account_name, keccak(rlptx2), 1),
+                           eosio_assert_message_exception, eosio_assert_message_is("inclusion price must >= min_inclusion_price"));
+   pushstaged(evm_account_name, keccak(rlptx2), 0, 1'000'000);
+   BOOST_REQUIRE_EQUAL(call_contract(silkworm::create_address(evm1.address, 1)).status, 0);
+
+   // A malformed staged transaction is rejected on commit and can be reset
+   produce_block();
+   stage(bytes{rlptx.begin(), rlptx.begin() + 10}, 8);
+   BOOST_REQUIRE_EXCEPTION(stagecommit(evm_account_name),
+                           eosio_assert_message_exception, eosio_assert_message_is("unable to decode transaction"));
+   BOOST_REQUIRE_EXCEPTION(pushstaged(evm_account_name, keccak(bytes{rlptx.begin(), rlptx.begin() + 10})),
+                           eosio_assert_message_exception, eosio_assert_message_is("staged transaction not committed"));
+   stagereset(evm_account_name);
+   BOOST_REQUIRE_EXCEPTION(pushstaged(evm_account_name, keccak(rlptx)),
+                           eosio_assert_message_exception, eosio_assert_message_is("no staged transaction"));
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(staged_requires_version_1, staged_tx_v0_evm_tester) try {
+
+   // At version 0 no evmtx event is emitted and EVM nodes only see pushtx action data
+   const auto rlptx = signed_deployment(100);
+   BOOST_REQUIRE_EXCEPTION(stagechunk(evm_account_name, rlptx),
+                           eosio_assert_message_exception, eosio_assert_message_is("staged transactions require evm_version >= 1"));
+   BOOST_REQUIRE_EXCEPTION(stagecommit(evm_account_name),
+                           eosio_assert_message_exception, eosio_assert_message_is("staged transactions require evm_version >= 1"));
+   BOOST_REQUIRE_EXCEPTION(pushstaged(evm_account_name, keccak(rlptx)),
+                           eosio_assert_message_exception, eosio_assert_message_is("staged transactions require evm_version >= 1"));
+
+   setversion(1, evm_account_name);
+   produce_blocks(2);
+
+   stage(rlptx, 64);
+   stagecommit(evm_account_name);
+   pushstaged(evm_account_name, keccak(rlptx));
+   BOOST_REQUIRE_EQUAL(call_contract(silkworm::create_address(evm1.address, 0)).status, 0);
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
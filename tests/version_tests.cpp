@@ -612,4 +612,186 @@ BOOST_FIXTURE_TEST_CASE(min_inclusion_price, version_tester) try {
 
 } FC_LOG_AND_RETHROW()
 
+
+BOOST_FIXTURE_TEST_CASE(compact_evmtx_event, version_tester) try {
+
+    auto config = get_config();
+
+    evm_eoa evm1;
+    const int64_t to_bridge = 1000000;
+
+    open("alice"_n);
+    transfer_token("alice"_n, evm_account_name, make_asset(to_bridge), "alice");
+
+    BOOST_REQUIRE_EXCEPTION(compactevmtx(true, "alice"_n),
+        missing_auth_exception, eosio::testing::fc_exception_message_starts_with("missing authority"));
+
+    setversion(1, evm_account_name);
+    produce_blocks(2);
+
+    // Fund evm1 address
+    transfer_token("alice"_n, evm_account_name, make_asset(to_bridge), evm1.address_0x());
+
+    auto [trace, contract_address] = deploy_test_contract(evm1);
+    auto data = evmc::from_hex(increment_);
+
+    compactevmtx(true);
+
+    silkworm::Transaction txin {
+      silkworm::UnsignedTransaction {
+        .type = silkworm::TransactionType::kLegacy,
+        .max_priority_fee_per_gas = config.gas_price,
+        .max_fee_per_gas = config.gas_price,
+        .gas_limit = 10'000'000,
+        .to = contract_address,
+        .data = *data
+      }
+    };
+
+    // pushtx only references the rlptx already present in its own action data
+    evm1.sign(txin);
+    trace = pushtx(txin);
+    BOOST_REQUIRE(trace->action_traces.size() == 2);
+    BOOST_REQUIRE(trace->action_traces[1].act.name == "evmtx"_n);
+
+    auto event = get_event_from_trace<evm_test::evmtx_compact>(trace->action_traces[1].act.data);
+    BOOST_REQUIRE(event.eos_evm_version == 1);
+    BOOST_REQUIRE(event.tx_index == 0);
+    BOOST_REQUIRE(event.base_fee_per_gas == config.gas_price);
+    BOOST_REQUIRE(retrieve(contract_address, evm1.address) == intx::uint256(1));
+
+    // Synthesized transactions keep the full form
+    auto to = evmc::bytes{std::begin(contract_address.bytes), std::end(contract_address.bytes)};
+    trace = call("alice"_n, to, silkworm::Bytes(evmc::bytes32{}), *data, 1000000, "alice"_n);
+    BOOST_REQUIRE(trace->action_traces.size() == 2);
+    BOOST_REQUIRE(trace->action_traces[1].act.name == "evmtx"_n);
+    auto event_v1 = get_event_from_trace<evm_test::evmtx_v1>(trace->action_traces[1].act.data);
+    BOOST_REQUIRE(event_v1.eos_evm_version == 1);
+
+    trace = transfer_token("alice"_n, evm_account_name, make_asset(to_bridge), evm1.address_0x());
+    BOOST_REQUIRE(trace->action_traces[3].act.name == "evmtx"_n);
+    event_v1 = get_event_from_trace<evm_test::evmtx_v1>(trace->action_traces[3].act.data);
+    BOOST_REQUIRE(event_v1.eos_evm_version == 1);
+
+    // Disabling goes back to the full form for pushtx
+    compactevmtx(false);
+    evm1.sign(txin);
+    trace = pushtx(txin);
+    BOOST_REQUIRE(trace->action_traces.size() == 2);
+    auto txout = get_tx_from_trace(trace->action_traces[1].act.data);
+    BOOST_REQUIRE(txout == txin);
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(fast_deposit_event, version_tester) try {
+
+    auto config = get_config();
+
+    evm_eoa evm1;
+    const int64_t to_bridge = 1000000;
+
+    open("alice"_n);
+    transfer_token("alice"_n, evm_account_name, make_asset(to_bridge), "alice");
+
+    BOOST_REQUIRE_EXCEPTION(fastdeposit(true, "alice"_n),
+        missing_auth_exception, eosio::testing::fc_exception_message_starts_with("missing authority"));
+
+    // Create evm1 through a regular bridge transaction
+    transfer_token("alice"_n, evm_account_name, make_asset(to_bridge), evm1.address_0x());
+
+    // Version 0 still pushes the bridge transaction even with the flag on
+    fastdeposit(true);
+    auto trace = transfer_token("alice"_n, evm_account_name, make_asset(to_bridge), evm1.address_0x());
+    BOOST_REQUIRE(trace->action_traces[3].act.name == "pushtx"_n);
+
+    setversion(1, evm_account_name);
+    produce_blocks(2);
+
+    // Compact pushtx events alone do not change deposits
+    fastdeposit(false);
+    compactevmtx(true);
+    trace = transfer_token("alice"_n, evm_account_name, make_asset(to_bridge), evm1.address_0x());
+    BOOST_REQUIRE(trace->action_traces[3].act.name == "evmtx"_n);
+    auto event_v1 = get_event_from_trace<evm_test::evmtx_v1>(trace->action_traces[3].act.data);
+    BOOST_REQUIRE(event_v1.eos_evm_version == 1);
+    compactevmtx(false);
+
+    // Deposits to an existing account without code are credited directly
+    fastdeposit(true);
+    const auto balance_before = evm_balance(evm1);
+    const auto inevm_before = inevm();
+    trace = transfer_token("alice"_n, evm_account_name, make_asset(to_bridge), evm1.address_0x());
+    BOOST_REQUIRE(trace->action_traces[3].act.name == "evmtx"_n);
+    auto deposit = get_event_from_trace<evm_test::evmtx_deposit>(trace->action_traces[3].act.data);
+    BOOST_REQUIRE(deposit.eos_evm_version == 1);
+    BOOST_REQUIRE(deposit.gas_price == config.gas_price);
+    BOOST_REQUIRE(deposit.to == to_bytes(evm1.address));
+    const auto deposited = intx::be::unsafe::load<intx::uint256>(reinterpret_cast<const uint8_t*>(deposit.value.data()));
+    BOOST_REQUIRE(deposited > 0);
+    BOOST_REQUIRE(*evm_balance(evm1) == *balance_before + deposited);
+    BOOST_REQUIRE(intx::uint256(inevm()) == intx::uint256(inevm_before) + deposited);
+
+    // New accounts still go through the EVM, continuing from the nonce used by the deposit
+    evm_eoa evm2;
+    trace = transfer_token("alice"_n, evm_account_name, make_asset(to_bridge), evm2.address_0x());
+    BOOST_REQUIRE(trace->action_traces[3].act.name == "evmtx"_n);
+    auto txout_new = get_tx_from_trace(trace->action_traces[3].act.data);
+    BOOST_REQUIRE(txout_new.nonce == deposit.nonce + 1);
+    BOOST_REQUIRE(*evm_balance(evm2) == deposited);
+
+    // Disabling goes back to the full form
+    fastdeposit(false);
+    trace = transfer_token("alice"_n, evm_account_name, make_asset(to_bridge), evm1.address_0x());
+    BOOST_REQUIRE(trace->action_traces[3].act.name == "evmtx"_n);
+    event_v1 = get_event_from_trace<evm_test::evmtx_v1>(trace->action_traces[3].act.data);
+    BOOST_REQUIRE(event_v1.eos_evm_version == 1);
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(fast_deposit_reserved_account, version_tester) try {
+
+    evm_eoa evm1;
+    const int64_t to_bridge = 1000000;
+
+    open("alice"_n);
+    transfer_token("alice"_n, evm_account_name, make_asset(to_bridge), evm1.address_0x());
+
+    setversion(1, evm_account_name);
+    produce_blocks(2);
+
+    const auto reserved = make_reserved_address(evm_account_name);
+
+    // Each deposit must leave the reserved sender and the contract balances the same way, fast or not
+    auto deposit = [&](bool fast) {
+        fastdeposit(fast);
+        const auto vault_before = intx::uint256(vault_balance(evm_account_name));
+        const auto inevm_before = intx::uint256(inevm());
+        transfer_token("alice"_n, evm_account_name, make_asset(to_bridge), evm1.address_0x());
+        auto row = find_account_by_address(reserved);
+        BOOST_REQUIRE(!!row);
+        return std::make_tuple(*row, intx::uint256(vault_balance(evm_account_name)) - vault_before,
+                               intx::uint256(inevm()) - inevm_before);
+    };
+
+    const auto [slow1, slow1_vault, slow1_inevm] = deposit(false);
+    const auto [fast1, fast1_vault, fast1_inevm] = deposit(true);
+    const auto [slow2, slow2_vault, slow2_inevm] = deposit(false);
+    const auto [fast2, fast2_vault, fast2_inevm] = deposit(true);
+
+    BOOST_REQUIRE(fast1.id == slow1.id);
+    BOOST_REQUIRE(fast1.nonce == slow1.nonce + 1);
+    BOOST_REQUIRE(slow2.nonce == fast1.nonce + 1);
+    BOOST_REQUIRE(fast2.nonce == slow2.nonce + 1);
+
+    BOOST_REQUIRE(fast1.balance == slow1.balance);
+    BOOST_REQUIRE(slow2.balance == fast1.balance);
+    BOOST_REQUIRE(fast2.balance == slow2.balance);
+
+    BOOST_REQUIRE(fast1_vault == slow1_vault);
+    BOOST_REQUIRE(fast2_vault == slow2_vault);
+    BOOST_REQUIRE(fast1_inevm == slow1_inevm);
+    BOOST_REQUIRE(fast2_inevm == slow2_inevm);
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()